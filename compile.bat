@@ -1,3 +1,3 @@
 cd /d %~dp0
-g++ -Wall page_replace_polymorphism.cpp -o page_replace_polymorphism
+g++ -Wall -O2 -pthread page_replace_polymorphism.cpp -o page_replace_polymorphism
 PAUSE
\ No newline at end of file
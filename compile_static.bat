@@ -1,5 +1,5 @@
 cd /d %~dp0
-g++.exe -Wall -c -g page_replace_polymorphism.cpp -o page_replace_polymorphism.o
-g++.exe -static -static-libgcc -static-libstdc++ -o "page_replace_polymorphism_static.exe" page_replace_polymorphism.o
+g++.exe -Wall -O2 -pthread -c -g page_replace_polymorphism.cpp -o page_replace_polymorphism.o
+g++.exe -static -static-libgcc -static-libstdc++ -pthread -o "page_replace_polymorphism_static.exe" page_replace_polymorphism.o
 del page_replace_polymorphism.o
 PAUSE
\ No newline at end of file
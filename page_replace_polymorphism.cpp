@@ -4,445 +4,2875 @@
 	cd /d %~dp0
 	g++ -Wall -std=c++11 pagereplace.cpp -o pagereplace
 	PAUSE
+
+	TO RUN WITHOUT ANY PROMPTS, ON A TRACE FILE:
+	
+	page_replace_polymorphism --trace <file> [--format text|u32|u64|packed] [--policies <name>[,<name>...]] [--frames <list>] [--threads <number>]
+	                          [--snapshots] [--summary] [--export <file> [--export-format text|csv|binary]] [--evictions <file>]
+	
+	"text" traces are integers separated by white space or commas. "u32" and "u64" traces are raw, native endian,
+	unsigned integers (one per reference). "packed" traces are made by "--pack" (below). Every trace file is memory mapped
+	where the operating system allows it.
+	"--frames" takes a list like "3", "1,2,4" or "1-16". Every algorithm (or the ones named with "--policies", e.g. "LRU,ARC") is run
+	with every number of frames, all at the same time.
+	"--summary" prints one line per algorithm instead of its table. Built with -DPAGE_REPLACE_STATS, that line also has the evictions,
+	the frame searches, the time and (on Linux, where "perf_event_open" is allowed) the cycles, cache misses and branch misses.
+	"--export" writes every run's snapshots (so it turns "--snapshots" on) to a file instead of the screen: as exactly what would have
+	been displayed ("text", the default), as CSV with a row for each frame of each run and the page it held after every snapshot,
+	or as raw binary page IDs. Tables are rendered on every thread at once, and written out in one go.
+	"--evictions" also writes every eviction of every run to a file, as CSV: the algorithm, its frames, the reference that caused it,
+	the frame, the page that was evicted and the page that took its place. Each run's rows go to a temporary file as they're made,
+	so a long trace doesn't keep them in memory.
+	
+	page_replace_polymorphism --trace <file> [--format text|u32|u64|packed] --pack <file>
+	
+	saves the trace in the "packed" format instead of running anything: blocks of 65536 page IDs, each stored as the difference
+	from the one before it in a zigzag varint, so most references take 1 or 2 bytes. The blocks are decoded in parallel when it's loaded.
+	"--unpack <file>" saves it as "u32" page IDs instead (interned ones, with "--page-size"). A "u32" trace is mapped and read where
+	it is, never copied, so any number of runs on it at the same time (e.g. sweeps on one machine) share a single copy in memory.
+	
+	page_replace_polymorphism --trace <file> [--format text|u32|u64|packed] --mrc <frames>
+	
+	prints the LRU and OPT page faults for every number of frames from 1 to <frames> as CSV, from one pass over the trace.
+	Add "--shards-rate <0..1>" and/or "--shards-budget <pages>" to estimate the curves from a hashed sample of the pages instead,
+	and "--shards-exact" to also report how far the estimates are from the exact curves.
+	
+	page_replace_polymorphism --trace <file> [--format text|u32|u64|packed] --profile [--profile-windows <list>]
+	
+	profiles the trace in one pass instead, as CSV: how many references had each reuse (LRU stack) distance, the working set size
+	W(t, window) over time and on average for each window (100, 1000, 10000 and 100000 references by default), and how many times
+	each page was used.
+	
+	page_replace_polymorphism --bench [--workload uniform|zipf|scan|loop|mixed|all] [--length <references>] [--pages <pages>]
+	                          [--skew <zipf skew>] [--seed <seed>] [--frames <list>] [--repeat <runs>]
+	
+	times every algorithm on seeded, synthetic reference strings and prints one JSON object per line for each run. With "--repeat",
+	each one runs that many times on the same object, and the time and heap allocations are those of the last run.
+	
+	page_replace_polymorphism --sweep <file>[,<file>...] [--format text|u32|u64|packed] [--policies <name>[,<name>...]] [--frames <list>]
+	                          [--threads <number>] [--output csv|json]
+	
+	runs every policy (all of them, or the ones named, e.g. "LRU,ARC") with every number of frames on every trace file, using every
+	core, and prints the page faults, hit ratio and time of each run as CSV (the default) or one JSON object per line.
+	
+	page_replace_polymorphism --stream [--format text|u32|u64] [--policies <name>[,<name>...]] [--frames <list>] [--window <references>]
+	                          [--threads <number>] [--output csv|json]
+	
+	runs the online policies (every one but the optimal ones) on page IDs piped into standard input, as they arrive, in constant memory,
+	and prints the page faults in every window of references (100000 by default), and in total so far.
+	
+	page_replace_polymorphism --tenants <file> [--format text|u32|u64] [--policies <name>[,<name>...]] [--frames <list>]
+	                          [--ws-window <references>] [--pff-interval <references>] [--threads <number>] [--output csv|json]
+	
+	simulates a trace of (process I.D., page) pairs, where each process is a tenant with pages of its own, with every number of
+	frames shared by all of them: under global replacement with every policy (or the ones named), and under local replacement (LRU
+	within each tenant) with an equal share of the frames, the working set of each tenant (its last 1000 references by default), and
+	page fault frequency (a tenant that faults again within 100 of its own references by default gets another frame). It prints one
+	row per tenant for each, with its page faults, the frames it held on average, and how often it thrashed or was squeezed by others.
+	
+	Any of these can take "--lookahead <references>" (10000 by default): how far ahead "Optimal with lookahead" can see. It can be
+	streamed too, but it only decides each reference once that many more have arrived, so its "window" column counts the references
+	it decided in each window.
+	
+	Any of these can also take "--page-size 4K|2M|1G" (or any power of 2 in bytes, or "1" for page numbers) when the trace holds raw
+	64 bit addresses, in decimal or "0x" hexadecimal text, or as u32/u64. Each address is shifted down to its page, and every distinct
+	page is given the next small ID, so the algorithms only ever see IDs from 0 up. Tables display the addresses, not the IDs.
 */
 
 // Include libraries.
 #include <algorithm>  // for copy_if()
+#include <atomic>
 #include <cctype>
+#include <cerrno>   /* EINTR */
+#include <climits>
 #include <cmath>
-#include <cstdlib> /* srand, rand */
+#include <cstdint>
+#include <cstdio>   /* snprintf */
+#include <cstring>
+#include <exception>
+#include <chrono>  /* steady_clock */
+#include <cstdlib> /* strtod */
 #include <ctime>   /* time */
 #include <functional>
+#include <iomanip>  /* setw */
 #include <iostream>
 #include <iterator>   // for the back_inserter
-#include <list>
 #include <locale>
 #include <memory> /* smart pointers */
+#include <new>    /* bad_alloc */
+#include <set>
 #include <sstream>
 #include <stdexcept>  /* required for defining and catching standard exceptions */
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits> /* true_type */
+#include <unordered_map>
 #include <vector>
+#if defined(_WIN32)
+#include <fcntl.h>    /* _O_BINARY */
+#include <fstream>
+#include <io.h>       /* _setmode, _read */
+#ifndef NOMINMAX
+#define NOMINMAX      // std::min and std::max, not the macros.
+#endif
+#ifndef NOGDI
+#define NOGDI         // the GDI function "Arc" would hide the "Arc" class.
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef PSAPI_VERSION
+#define PSAPI_VERSION 2 // "GetProcessMemoryInfo" is then in kernel32, so compile.bat doesn't have to link psapi.
+#endif
+#include <windows.h>
+#include <psapi.h>    /* GetProcessMemoryInfo */
+#else
+#include <fcntl.h>    /* open */
+#include <sys/mman.h> /* mmap */
+#include <sys/resource.h> /* getrusage */
+#include <sys/stat.h> /* fstat */
+#include <unistd.h>   /* close */
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FRAME_SEARCH_X86 // the vectorized frame search kernels can be built, and picked at runtime.
+#include <immintrin.h> /* SSE2, AVX2, AVX-512 intrinsics */
+#endif
+// Build with -DPAGE_REPLACE_STATS to count and time what every algorithm does (see "algorithmStats"). Without it, none of the
+// instrumentation is compiled in at all.
+#if defined(PAGE_REPLACE_STATS) && defined(__linux__)
+#include <linux/perf_event.h> /* perf_event_attr */
+#include <sys/ioctl.h>        /* ioctl */
+#include <sys/syscall.h>      /* SYS_perf_event_open */
+#endif
 
 // Class(es).
 //================================================================================================================
-// This is the BASE/PARENT class where most of the data members for each algorithm are stored.
-// It's best not to change anything in this class, as it's what all objects rely on for their functionality!
-class algorithmType
-{
-	private:              // it's best practice to declare member variables here, directly in the private section of object.
-		std::string name; // Initialize all non-static variables in initialization list and all static variables directly below object.
-		unsigned int row; // Row of each objects' two dimensional, algorithm vector. Unknown until the end of each calculation.
-		unsigned int miss; // Variable that stores each page fault that's found.
-	    unsigned int myid; // "myid" assigns each object created with it's own identification number (starts at 1).
-		// Set as static because only one instance is to be used for all objects.
-		static unsigned int maxid; // Ensures if an object is deleted that no identical id is assigned to a new object.
-		static unsigned int frame; // Keeps track of the number of frames. Stored as a column.
-		static unsigned int numobj; // Keeps track of how many objects of this class were created.
-		std::vector<int> currentcashline;
-		std::vector<std::vector<int>> alg;
-
-	public:
-	    algorithmType() : algorithmType("<N/A>"){} // Delegating constructor (C++11 feature).
-		algorithmType(std::string pname) : name(pname), row(0), miss(0) // never rely on non-member functions to initialize member variables.
-		{
-		 numobj++; // static variables were already initialized below this object, so now they can modify their values.
-		 maxid++;
-		 myid = maxid; // this non-static member variable can't be initialized in initialization list because "maxid" is not allowed there.
-		}
-
-		// Destructor.
-		// It's good practice to make the destructor virtual in the case that a pointer object is destroyed,
-		// there is no undefined behavior.
-		virtual ~algorithmType() 
-		{
-			if (numobj > 0)
-			{numobj--;}
-		}
+class algorithmType;
 
-		// Pure virtual function that NEEDS to exist within every object of this class, as every object of this
-		// class has that member function called for it automatically. Plus, without it, there would be nothing to display!
-		virtual void calculateAlgorithm(const int &refstrcount, const std::vector<int> &refstr) = 0;
+// These functions look for a page in a cache line and return its frame index, or "count" if it isn't there.
+// Each one compares the page with as many frames at once as its instruction set allows. "findFrame" picks the widest one
+// the processor supports the first time it's called, and falls back to the plain loop everywhere else.
+typedef std::size_t (*frameSearch)(const int *frames, std::size_t count, int page);
 
-		virtual void setMiss (unsigned int smiss) final
-		{miss = smiss;}
+std::size_t findFrameScalar(const int *frames, std::size_t count, int page)
+{
+ std::size_t i = 0;
+	while (i < count && frames[i] != page)
+	{i++;}
+ return i;
+}
 
-		// The "final" specifier (along with the needed "virtual" keyword) work together to ensure these functions are NEVER overridden!
-	    virtual void setRow (unsigned int srow) final
-		{row = srow;}
+#ifdef FRAME_SEARCH_X86
+__attribute__((target("sse2"))) std::size_t findFrameSse2(const int *frames, std::size_t count, int page)
+{
+ __m128i key = _mm_set1_epi32(page);
+ std::size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+	 int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(frames + i)), key)));
+		if (mask != 0)
+		{return i + __builtin_ctz(mask);}
+	}
+ return i + findFrameScalar(frames + i, count - i, page);
+}
 
-		// Returning member by reference.
-		// This breaks encapsulation, but it saves space and it's the most important member, which defines the use of this entire program.
-		virtual std::vector<std::vector <int>> &setVector () final
-		{return alg;}
+__attribute__((target("avx2"))) std::size_t findFrameAvx2(const int *frames, std::size_t count, int page)
+{
+ __m256i key = _mm256_set1_epi32(page);
+ std::size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+	 int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(frames + i)), key)));
+		if (mask != 0)
+		{return i + __builtin_ctz(mask);}
+	}
+ return i + findFrameScalar(frames + i, count - i, page);
+}
 
-		// This function is static so it may be called without an object, as it applies to all objects.
-		static void static_setFrameFinalSize (unsigned int sframe)
-		{frame = sframe;}
+__attribute__((target("avx512f"))) std::size_t findFrameAvx512(const int *frames, std::size_t count, int page)
+{
+ __m512i key = _mm512_set1_epi32(page);
+	for (std::size_t i = 0; i < count; i += 16) // the last, partial block is loaded through a mask, so nothing past the end is read.
+	{
+	 __mmask16 load = (count - i >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << (count - i)) - 1));
+	 unsigned int mask = _mm512_mask_cmpeq_epi32_mask(load, _mm512_maskz_loadu_epi32(load, frames + i), key);
+		if (mask != 0)
+		{return i + __builtin_ctz(mask);}
+	}
+ return count;
+}
+#endif
 
-		virtual std::vector<int> &setCurrentCacheLine () final
-		{return currentcashline;}
+frameSearch chooseFrameSearch()
+{
+#ifdef FRAME_SEARCH_X86
+ __builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+	{return findFrameAvx512;}
+	if (__builtin_cpu_supports("avx2"))
+	{return findFrameAvx2;}
+	if (__builtin_cpu_supports("sse2"))
+	{return findFrameSse2;}
+#endif
+ return findFrameScalar;
+}
 
-		virtual unsigned int getFrameFinalSize () final
-		{return frame;}
+// How many frame searches were made, and how many frames they compared, counted per thread (so a calculation can tell its own
+// searches apart from the ones on other threads). Only when built with PAGE_REPLACE_STATS.
+#ifdef PAGE_REPLACE_STATS
+thread_local unsigned long long framelookups = 0;
+thread_local unsigned long long frameprobes = 0;
+#endif
 
-		virtual unsigned int getMiss () final
-		{return miss;}
+inline void countFrameSearch(std::size_t found, std::size_t count)
+{
+#ifdef PAGE_REPLACE_STATS
+ framelookups++;
+ frameprobes += (found < count ? found + 1 : count);
+#else
+ (void)found;
+ (void)count;
+#endif
+}
 
-		virtual unsigned int getMyId () final // Every object created will have it's own unique I.D., accessible to view via this method.
-		{return myid;}
+inline std::size_t findFrame(const int *frames, std::size_t count, int page)
+{
+ std::size_t found;
+	if (count < 4) // too few frames for a vector compare to pay for the call.
+	{found = findFrameScalar(frames, count, page);}
+	else
+	{
+	 static const frameSearch search = chooseFrameSearch();
+	 found = search(frames, count, page);
+	}
+ countFrameSearch(found, count);
+ return found;
+}
 
-		virtual const std::string &getName() final
-		{return name;}
+// What one "calculateAlgorithm" call did, and what it cost. The hits and page faults are always there; everything else is only
+// counted when built with PAGE_REPLACE_STATS ("instrumented"), and the hardware counters only on Linux, when "perf_event_open"
+// is allowed ("hardware"). See "algorithmType::getStats".
+struct algorithmStats
+{
+ bool instrumented = false;
+ unsigned long long hits = 0;
+ unsigned long long misses = 0;
+ unsigned long long evictions = 0;
+ unsigned long long snapshotbytes = 0; // bytes of cache lines captured.
+ unsigned long long lookups = 0; // linear searches of the frames.
+ unsigned long long probes = 0; // frames compared by those searches.
+ double seconds = 0.0;
+ bool hardware = false;
+ unsigned long long cycles = 0;
+ unsigned long long cachemisses = 0;
+ unsigned long long branchmisses = 0;
+};
 
-		virtual unsigned int getRow () final
-		{return row;}
+#if defined(PAGE_REPLACE_STATS) && defined(__linux__)
+// This is a HELPER class that counts the processor's cycles, cache misses and branch misses for the thread that made it, in user
+// space only, between "start" and "stop". If any of the counters can't be opened (no permission, a virtual machine without a PMU),
+// "stop" leaves the hardware counts out.
+class hardwareCounters
+{
+ public:
+	hardwareCounters()
+	{
+	 static const std::uint64_t events[3] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+		for (int e = 0; e < 3; e++)
+		{
+		 perf_event_attr attr;
+		 std::memset(&attr, 0, sizeof(attr));
+		 attr.type = PERF_TYPE_HARDWARE;
+		 attr.size = sizeof(attr);
+		 attr.config = events[e];
+		 attr.disabled = 1;
+		 attr.exclude_kernel = 1;
+		 attr.exclude_hv = 1;
+		 fds[e] = (int)::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0); // this thread, on any CPU.
+		}
+	}
 
-		virtual const std::vector<std::vector <int>> &getVector () final
-		{return alg;}
-		
-		static unsigned int static_getFrameFinalSize ()
-		{return frame;}
+	~hardwareCounters()
+	{
+		for (int &fd : fds)
+		{
+			if (fd >= 0)
+			{::close(fd);}
+		}
+	}
 
-		static unsigned int static_getNumObj () // This function is static so the number of objects that exist can be displayed without the need of any one specific object.
-		{return numobj;}
+	hardwareCounters(const hardwareCounters &) = delete;
+	hardwareCounters &operator=(const hardwareCounters &) = delete;
 
-		virtual void clearAlg () final // This clears the vector's contents and size to zero.
+	void start()
+	{
+		for (int &fd : fds)
 		{
-			for(std::vector<int> &i : alg)
+			if (fd >= 0)
 			{
-			 i.clear();
-			 std::vector<int>().swap(i);
+			 ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			 ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
 			}
-		 alg.clear();
-		 std::vector<std::vector<int>>().swap(alg);
 		}
+	}
 
-		virtual void displayAlgorithm() // All 3 algorithms can be displayed in the same manner using this member function. If not, override it in derived class.
+	void stop(algorithmStats &stats)
+	{
+	 unsigned long long counts[3] = {0, 0, 0};
+	 stats.hardware = true;
+		for (int e = 0; e < 3; e++)
 		{
-		 std::cout << name << " page faults: " << getMiss() << std::endl;
-			for (unsigned int a = 0; a < getFrameFinalSize(); a++) // this display method displays this multidimensional vector inversely to match textbooks etc.
+			if (fds[e] < 0)
 			{
-				for (unsigned int i = 0; i < getVector().size(); i++) // 'getVector().size()' is the same as 'getRow()'.
-				{
-					// getFrameFinalSize() doesn't account for the reference string possibly not having as many unique numbers
-					// as there are frames, which was calculated in the 'getInput' function from the user's input.
-					if (a < getVector()[i].size())
-					{
-					 std::cout << getVector()[i][a];
-						if ((i + 1) < getVector().size())
-						{
-						 std::cout << " ";
-						}
-					}
-				}
-				// This works just fine, but had this been a jagged array/vector, we would want to instead make sure that 'a',
-				// which is the outer loop, is less than the BIGGEST 'getVector()[i].size()' from the inner loop.
-				if ((a + 1) < getVector()[0].size())
-				{
-				 std::cout << std::endl;
-				}
-				else
-				{
-				 // We know that if the row we're currently checking (indexed by 'a') is equal to the maximum column size,
-				 // because it's zero indexed, then there won't be anything left in the column ('getVector()[0].size()').
-					
-					// Not really necessary, but without this check, this conditional statement would explicitly break out
-					// of the outer loop on the last iteration, every single time, and not just when needed.
-					if ((a + 1) < getFrameFinalSize())
-					{
-					 break;
-					}
-				}
+			 stats.hardware = false;
+			 continue;
 			}
+		 ::ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+			if (::read(fds[e], &counts[e], sizeof(counts[e])) != (ssize_t)sizeof(counts[e]))
+			{stats.hardware = false;}
 		}
-
-		virtual int fillFirstCacheLine(const std::vector<int> &refstr, const int &refstrcount) final
+		if (stats.hardware)
 		{
-		 setCurrentCacheLine().clear();
-		 std::vector<int>().swap(setCurrentCacheLine());
-		 int currentrefstr = 0;
-			for (int i = 0; i < refstrcount; i++) // we're looping through entire reference string just in case there are repeating numbers at beginning
-			{
-				if (std::find(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), refstr[i]) == setCurrentCacheLine().end()) // As long as no duplicate pages were found in the first frame...
-				{
-				 setMiss(getMiss() + 1); // page miss, then decide what to do next depending on the algorithm.
-				 setCurrentCacheLine().push_back(refstr[i]);
-				}
-				if (setCurrentCacheLine().size() >= getFrameFinalSize() || (i + 1 >= refstrcount)) // create first line of cache now that all pages have been added to all frames.
-				{
-				 currentrefstr = i + 1;
-				 setRow(getRow() + 1);
-				 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-				 break;
-				}
-			}
-		 return currentrefstr;
+		 stats.cycles = counts[0];
+		 stats.cachemisses = counts[1];
+		 stats.branchmisses = counts[2];
 		}
+	}
 
+ private:
+	int fds[3];
 };
+#endif
 
-// Initializing the static variable 'row', but this is, and can ONLY be initialized once, which it is here.
-unsigned int algorithmType :: frame = 0; // This can NOT be less than zero because variable "fcount" in function "calculateFifo" is an unsigned int.
-unsigned int algorithmType :: numobj = 0; // No objects of this class have been created yet.
-unsigned int algorithmType :: maxid = 0; // No objects of this class have been created yet.
-
-// This is a DERIVED/CHILD class, signified by inheriting from class "algorithmType".
-// For every new algorithm added, a new derived class that inherits "algorithmType" needs to be added.
-// The only entity that needs to be added to these classes is the member function "calculateAlgorithm".
-// This is because calculating each algorithm is unique to each algorithm. And any other unique functionality
-// that these algorithms have needs to be added to it's specific (derived) class.
-class Fifo : public algorithmType
+// This is a HELPER class that stores every cache line (snapshot) of an algorithm in one contiguous, row-major buffer.
+// Each row is "width()" frames wide, so adding a row never allocates on its own and the rows can be walked linearly.
+// Indexing a row returns a lightweight view, so "getVector()[i][a]" and "getVector()[i].size()" work just like a vector of vectors.
+class snapshotBuffer
 {
  public:
- Fifo(){} // Default Constructor
- Fifo(std::string pname) : algorithmType(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+	class row
+	{
+	 public:
+		row(const int *pdata, unsigned int psize) : rowdata(pdata), rowsize(psize){}
+		const int &operator[](unsigned int a) const
+		{return rowdata[a];}
+		unsigned int size() const
+		{return rowsize;}
+		const int *begin() const
+		{return rowdata;}
+		const int *end() const
+		{return rowdata + rowsize;}
+	 private:
+		const int *rowdata;
+		unsigned int rowsize;
+	};
 
-	virtual void calculateAlgorithm(const int &refstrcount, const std::vector<int> &refstr) override // Required for all derived classes of "algorithmType".
+	snapshotBuffer() : rowwidth(0), rows(0){}
+
+	void push_back(const std::vector<int> &cacheline) // every row of one calculation has the same width as the first one.
 	{
-	 unsigned int fcount = 0; // keeps track of index of the first page added to cache.
-	 int start = fillFirstCacheLine(refstr, refstrcount); // fill in first cache line of frames
-		for (int i = start; i < refstrcount; i++)
-		{
-			if (std::find(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), refstr[i]) == setCurrentCacheLine().end()) // If nothing in current cache of frames matches the current element in reference string...
-			{
-			 setMiss(getMiss() + 1); // page miss, then decide what to do next depending on the algorithm.
-			 setCurrentCacheLine()[fcount] = refstr[i]; // replace next frame in the count with the current reference string.
-			 ((fcount + 1 < getFrameFinalSize()) ? fcount++ : fcount = 0);
-			 setRow(getRow() + 1);
-			 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-			}
-		}
+		if (rows == 0)
+		{rowwidth = (unsigned int)cacheline.size();}
+	 buffer.insert(buffer.end(), cacheline.begin(), cacheline.begin() + rowwidth);
+	 rows++;
 	}
 
-};
+	row operator[](std::size_t r) const
+	{return row(buffer.data() + r * rowwidth, rowwidth);}
 
-class Lru : public algorithmType
-{
- public:
- Lru(){} // Default Constructor
- Lru(std::string pname) : algorithmType(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+	std::size_t size() const
+	{return rows;}
+
+	bool empty() const
+	{return rows == 0;}
+
+	unsigned int width() const
+	{return rowwidth;}
 
-	virtual void calculateAlgorithm(const int &refstrcount, const std::vector<int> &refstr) override // Required for all derived classes of "algorithmType".
+	const int *data() const // all rows, one after another.
+	{return buffer.data();}
+
+	void clear() // This clears the buffer's contents and size to zero. Its memory is kept for the next run.
 	{
-	 // This algorithm uses the "stack" method, as it requires less code and is easier to understand. However, it is slightly slower than "counters".
-	 std::list<int> lst;
-	 int start = fillFirstCacheLine(refstr, refstrcount);  // fill in first cache line of frames
-	 std::copy(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), std::back_inserter(lst));
-		for (int i = start; i < refstrcount; i++)
-		{
-			if (std::find(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), refstr[i]) == setCurrentCacheLine().end()) // If nothing in current cache of frames matches the current element in reference string...
-			{
-			 setMiss(getMiss() + 1); // page miss, then decide what to do next depending on the algorithm.
-			 std::replace(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), lst.front(), refstr[i]);
-			 lst.pop_front();
-			 setRow(getRow() + 1);
-			 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-			}
-			else
-			{
-			 lst.erase(std::find(lst.begin(), lst.end(), refstr[i]));
-			}
-		 lst.push_back(refstr[i]);
-		}
+	 buffer.clear();
+	 rowwidth = 0;
+	 rows = 0;
 	}
- 
+
+ private:
+	std::vector<int> buffer;
+	unsigned int rowwidth;
+	std::size_t rows;
 };
 
-class Opt : public algorithmType
+// This is an INTERFACE class for anything that wants to be told about each reference as an algorithm is calculated.
+// Override only what's needed; every member function does nothing by default. An observer is optional, and without one
+// nothing is called at all, so it costs nothing when only the page fault count is wanted.
+class algorithmObserver
+{
+ public:
+	virtual ~algorithmObserver(){}
+	virtual void onHit(const algorithmType &, int /*position*/, int /*page*/){}
+	virtual void onMiss(const algorithmType &, int /*position*/, int /*page*/){}
+	virtual void onEvict(const algorithmType &, int /*position*/, unsigned int /*frame*/, int /*evicted*/, int /*page*/){}
+};
+
+// This function mixes the bits of a 64 bit value into a 64 bit hash (the "splitmix64" finalizer), so that anything indexed or sampled
+// by the hash (the page interner, the frequency sketch and SHARDS below) is spread evenly, no matter how the values are spread out.
+std::uint64_t hashAddress(std::uint64_t address)
+{
+ std::uint64_t z = address + 0x9E3779B97F4A7C15ull;
+ z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+ z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+ return z ^ (z >> 31);
+}
+
+// This is a HELPER class (not an algorithm) that turns raw 64 bit addresses into dense page IDs: the first page seen gets 0, the next
+// new one gets 1, and so on. Every address is shifted right by "shift" bits first (12 for 4K pages, 21 for 2M pages, 30 for 1G pages),
+// so all the addresses in one page get the same ID. With a shift of 0, the "addresses" are already page numbers.
+// The table is open addressing with linear probing, never more than half full, and each slot keeps its page number next to its ID,
+// so a lookup is usually one cache line. The page numbers are also kept in order of their IDs, to show the original addresses again.
+//================================================================================================================
+class pageInterner
 {
  public:
- Opt(){} // Default Constructor
- Opt(std::string pname) : algorithmType(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+	explicit pageInterner(unsigned int pshift = 0) : shift(pshift), mask(0) {}
 
-	virtual void calculateAlgorithm(const int &refstrcount, const std::vector<int> &refstr) override // Required for all derived classes of "algorithmType".
+	// Returns the ID of the page that "address" is in, giving the page the next ID if it hasn't been seen before.
+	// Returns -1 if it's a new page, but every ID an 'int' can hold is already taken.
+	int intern(std::uint64_t address)
 	{
-	 int maxindex = 0, maxdistance = 0, currentdistance;
-	 std::vector<int>::const_iterator cnst_itr_pos;
-	 int start = fillFirstCacheLine(refstr, refstrcount);  // fill in first cache line of frames
-		for (int i = start; i < refstrcount; i++)
+	 std::uint64_t page = address >> shift;
+		if ((pages.size() + 1) * 2 > slots.size())
+		{grow();}
+	 std::size_t s = (std::size_t)hashAddress(page) & mask;
+		while (slots[s].id != none)
 		{
-			if (std::find(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), refstr[i]) == setCurrentCacheLine().end()) // If nothing in current cache of frames matches the current element in reference string...
-			{
-			 setMiss(getMiss() + 1); // page miss, then decide what to do next depending on the algorithm.
-			 maxdistance = 0; // must reset the max value found for each new iteration of the reference string
-				for (unsigned int c = 0; c < getFrameFinalSize(); c++) // loop through each frame in the current cache
-				{
-				 // even though "(refstr.begin() + i)" is the current element in the reference string (refstr), it is guaranteed not to be in the current cache of frames (setCurrentCacheLine())
-				 // at this point, so including "(refstr.begin() + i)" will NOT return any false positive distances of zero
-					 
-				 // get position of where the first occurrence of the current frame is in the reference string (refstr)
-				 cnst_itr_pos = std::find ((refstr.begin() + (i)), refstr.end(), setCurrentCacheLine()[c]);
-				 currentdistance = std::distance((refstr.begin() + (i)), cnst_itr_pos); // gets the distance of the next number in the reference string (refstr) that matches the current element in the cache (setCurrentCacheLine())
-					if (i < (refstrcount - 1)) // If the main loop (iterating through the reference string) is NOT at the last element yet... (last element MIGHT need handled differently)
-					{
-						if (cnst_itr_pos == refstr.end()) // if current element in setCurrentCacheLine() is NOT in any future element of refstr...
-						{
-						 setCurrentCacheLine()[c] = refstr[i]; // the number in "setCurrentCacheLine()[c]" was not found anywhere else in the reference string, first, so it is selected to store the current element of the reference string (refstr)
-						 setRow(getRow() + 1);
-						 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-						 break; // break out of looping through each frame in the cache line, since we are changing a frame
-						}
-							if (currentdistance > maxdistance) // if distance of current element of setCurrentCacheLine() in reference string is greater than the max distance so far...
-							{
-							 maxdistance = currentdistance; // if there are two elements with same max distance, the first element that had it is chosen
-							 maxindex = c;
-							}
-								if (c >= (getFrameFinalSize() - 1)) // if this loop IS at the last element of the cache line (setCurrentCacheLine())...
-								{
-								 setCurrentCacheLine()[maxindex] = refstr[i];
-								 setRow(getRow() + 1);
-								 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-								 // no need to 'break' out of for loop because we're at the last element anyway
-								}
-					}
-					else // at the last element of reference string... simply replaces first element in cache line (setCurrentCacheLine()) with the last element in the reference string (refstr)
-					{
-					 setCurrentCacheLine()[0] = refstr[i];
-					 setRow(getRow() + 1);
-					 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-					 break;
-					}
-				}
-			}
+			if (slots[s].page == page)
+			{return (int)slots[s].id;}
+		 s = (s + 1) & mask;
 		}
+		if (pages.size() > (std::size_t)INT_MAX)
+		{return -1;}
+	 slots[s].page = page;
+	 slots[s].id = (std::uint32_t)pages.size();
+	 pages.push_back(page);
+	 return (int)slots[s].id;
 	}
 
-};
+	std::size_t size() const // the number of distinct pages so far.
+	{return pages.size();}
 
-class Opt_Fifo : public algorithmType
-{
- public:
- Opt_Fifo(){} // Default Constructor
- Opt_Fifo(std::string pname) : algorithmType(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+	unsigned int getShift() const
+	{return shift;}
+
+	std::uint64_t getAddress(int id) const // the first address of the page with this ID.
+	{return pages[(std::size_t)id] << shift;}
 
-	virtual void calculateAlgorithm(const int &refstrcount, const std::vector<int> &refstr) override // Required for all derived classes of "algorithmType".
+ private:
+	static const std::uint32_t none = 0xFFFFFFFFu; // an empty slot.
+	struct slot
 	{
-	 int maxindex = 0, maxdistance = 0, currentdistance, nomatch, fifoindex, fifodistance, fifomindistance;
-	 std::vector<int>::const_iterator cnst_itr_pos;
-	 std::vector<int>::const_iterator cnst_itr_match;
-	 int start = fillFirstCacheLine(refstr, refstrcount);  // fill in first cache line of frames
-		for (int i = start; i < refstrcount; i++)
+	 std::uint64_t page;
+	 std::uint32_t id;
+	};
+
+	void grow() // doubles the table, and puts every page back into it.
+	{
+	 slots.assign(std::max<std::size_t>(1024, slots.size() * 2), slot{0, none});
+	 mask = slots.size() - 1;
+		for (std::size_t id = 0; id < pages.size(); id++)
 		{
-			if (std::find(setCurrentCacheLine().begin(), setCurrentCacheLine().end(), refstr[i]) == setCurrentCacheLine().end()) // If nothing in current cache of frames matches the current element in reference string...
-			{
-			 setMiss(getMiss() + 1); // page miss, then decide what to do next depending on the algorithm.
-			 maxdistance = 0; // must reset the max value found for each new iteration of the reference string
-			 nomatch = 0; // reset so new frames with no match in reference string (refstr) start fresh for each iteration of the reference string
-				for (unsigned int c = 0; c < getFrameFinalSize(); c++) // loop through each frame in the current cache
-				{
-				 // even though "(refstr.begin() + i)" is the current element in the reference string (refstr), it is guaranteed not to be in the current cache of frames (setCurrentCacheLine())
-				 // at this point, so including "(refstr.begin() + i)" will NOT return any false positive distances of zero
-					 
-				 // get position of where the first occurrence of the current frame is in the reference string (refstr)
-				 cnst_itr_pos = std::find ((refstr.begin() + (i)), refstr.end(), setCurrentCacheLine()[c]);
-				 currentdistance = std::distance((refstr.begin() + (i)), cnst_itr_pos); // gets the distance of the next number in the reference string (refstr) that matches the current element in the cache (setCurrentCacheLine())
-					if (cnst_itr_pos == refstr.end()) // if current element in setCurrentCacheLine() is NOT in any future element of refstr...
-					{nomatch++;}
-					else // current element in setCurrentCacheLine() IS in any future element of refstr...
-					{
-						if (currentdistance > maxdistance) // if distance of current element of setCurrentCacheLine() in reference string is greater than the max distance so far...
-						{
-						 maxdistance = currentdistance; // if there are two elements with same max distance, the first element that had it is chosen
-						 maxindex = c;
-						}
-					}
-				}
-			 fifoindex = 0;
-			 fifomindistance = refstrcount; // because refstrcount is always going to be 1 element passed the last element in refstr, we will know that the value has NOT changed yet
-				if (nomatch > 1) //  if there were two or more elements of the cache line that were not found anywhere in the future of the reference string...
-				{
-					for (unsigned int d = 0; d < getFrameFinalSize(); d++) // at least 2 frames were not found in future refstr, so loop over frames again and use to Fifo to determine which frame comes first
-					{
-						if (std::find ((refstr.begin() + (i)), refstr.end(), setCurrentCacheLine()[d]) == refstr.end()) // only frames that had no match will be considered
-						{
-						 cnst_itr_match = std::find (refstr.begin(), (refstr.begin() + (i)), setCurrentCacheLine()[d]); // find position of the first occurence of the current frame inside of the reference string, starting from beginning
-						 fifodistance = std::distance(refstr.begin(), cnst_itr_match); // find distance of recently found position of "cnst_itr_match" in refstr
-							if (fifodistance < fifomindistance)
-							{
-							 fifomindistance = fifodistance;
-							 fifoindex = d;
-							}
-						}
-					}
-				 setCurrentCacheLine()[fifoindex] = refstr[i];
-				}
-				else if (nomatch == 1)
-				{
-					for (unsigned int e = 0; e < getFrameFinalSize(); e++) // because there's only one frame that didn't have a match in refstr, we know that frame will be the last frame in the cache to be replaced next
-					{
-						if (std::find ((refstr.begin() + (i)), refstr.end(), setCurrentCacheLine()[e]) == refstr.end()) // once we find the one and only frame that has no match, we're done looking
-						{
-						 setCurrentCacheLine()[e] = refstr[i];
-						 break; // break from searching the one and only frame with no match and go ahead with next element in the reference string
-						}
-					}
-				}
-				else // if "nomatch" is zero... then use the original max distance found between all frames in cache
-				{
-				 setCurrentCacheLine()[maxindex] = refstr[i];
-				}
-			 setRow(getRow() + 1);
-			 setVector().push_back(setCurrentCacheLine()); // add finished frames to the cache.
-			}
+		 std::size_t s = (std::size_t)hashAddress(pages[id]) & mask;
+			while (slots[s].id != none)
+			{s = (s + 1) & mask;}
+		 slots[s] = slot{pages[id], (std::uint32_t)id};
 		}
 	}
 
+	unsigned int shift;
+	std::size_t mask;
+	std::vector<slot> slots;
+	std::vector<std::uint64_t> pages; // ID -> page number.
 };
 
-// Functions.
-//================================================================================================================
-
-// This function removes all whitespace completely.
-//================================================================================================================
-void remove_all_whitespaces(std::string &str)
-{str.erase(remove_if(str.begin(), str.end(), [](char ch){return std::isspace<char>(ch, std::locale::classic());} ), str.end());}
+// Every allocation from the heap is counted, so the benchmark can show how many each run makes. Once an algorithm has run once,
+// running it again on the same number of frames shouldn't have to make any at all.
+std::atomic<unsigned long long> heapallocations(0);
 
-// These functions trim the white spaces from either side of the input.
-//================================================================================================================
-// trim from start
-std::string &ltrim(std::string &s)
+void *operator new(std::size_t size)
 {
- //s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](char c) {return (bool)!(std::isspace(c));}));
- s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](char ch){return (bool)!(std::isspace<char>(ch, std::locale::classic()));} ));
- return s;
+ heapallocations.fetch_add(1, std::memory_order_relaxed);
+ void *p = std::malloc(size == 0 ? 1 : size);
+	if (p == nullptr)
+	{throw std::bad_alloc();}
+ return p;
 }
 
-// trim from end
-std::string &rtrim(std::string &s)
-{
- //s.erase(std::find_if(s.rbegin(), s.rend(), [](char c) {return (bool)!(std::isspace(c));}).base(), s.end());
- s.erase(std::find_if(s.rbegin(), s.rend(), [](char ch){return (bool)!(std::isspace<char>(ch, std::locale::classic()));} ).base(), s.end());
- return s;
-}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11 // GCC can't tell "free" is given what this "new" got from "malloc".
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void *p) noexcept
+{std::free(p);}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
 
-// trim from both ends
-std::string &trim(std::string &s)
-{return ltrim(rtrim(s));}
+#ifdef __cpp_sized_deallocation
+void operator delete(void *p, std::size_t) noexcept
+{::operator delete(p);}
+#endif
 
-// This function merges all multiple white spaces in a row, into one 'space', even if no 'space' character is found.
-// For practical usability, this function allows ANY white spaces in a row ('space', tab, newline, etc.) to be used as a delimiter.
-//================================================================================================================
-void remove_extra_whitespaces(std::string &input) //, std::string &output)
+// This is a HELPER class that hands out the memory for the state of one run of an algorithm (its page -> frame maps and the like).
+// Blocks are carved out of a few big chunks, one after another, and a block that's given back is kept on a list for its size,
+// for the next block of that size. "reset" forgets every block at once but keeps the chunks, so the next run draws from the same
+// memory, and once the chunks are as big as a run needs, the heap is never asked for more.
+class runArena
 {
- std::string output; // = "NO_OUTPUT_YET";
- output.clear();  // unless you want to add at the end of existing string, clear the output so it's ready to accept new input.
- //unique_copy (input.begin(), input.end(), std::back_insert_iterator<std::string>(output), [](char a,char b){ return std::isspace(a) && std::isspace(b);});
- unique_copy (input.begin(), input.end(), std::back_insert_iterator<std::string>(output), [](char a, char b){return std::isspace<char>(a, std::locale::classic()) && std::isspace<char>(b, std::locale::classic());} );
- replace_if(output.begin(), output.end(), [](char ch){return std::isspace<char>(ch, std::locale::classic());} , ' '); // makes all characters that are any type of whitespace into single 'space'.
- input = output;
-}
+ public:
+ runArena() : chunk(0), used(0), freelist(){}
+	runArena(const runArena &) = delete; // every algorithm has its own.
+	runArena &operator=(const runArena &) = delete;
 
-// This function acts as "cin>>", but without the headache of having to worry about maintaining the input buffer.
-// The use of "cin >>" requires "std::cin.clear()" and "std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n')"
-// immediately after you use it. This method is cleaner, safer and more portable.
-//================================================================================================================
-void cin_custom(std::string &str)
-{
- getline(std::cin, str); // Causes a newline to be created here as well.
- ltrim(str);
-	for(unsigned int i = 0; i < str.length(); i++)
+	void *allocate(std::size_t bytes)
 	{
-		if (std::isspace(str[i]))
+	 std::size_t size;
+	 unsigned int c = sizeClass(bytes, size);
+		if (freelist[c] != nullptr) // the first bytes of a free block point to the next one of its size.
+		{
+		 void *p = freelist[c];
+		 freelist[c] = *static_cast<void **>(p);
+		 return p;
+		}
+		while (chunk < chunks.size() && used + size > chunksizes[chunk]) // whatever is left of a chunk that's too small is skipped.
+		{
+		 chunk++;
+		 used = 0;
+		}
+		if (chunk == chunks.size())
+		{
+		 std::size_t chunksize = (chunks.empty() ? firstchunk : 2 * chunksizes.back());
+			if (chunksize < size)
+			{chunksize = size;}
+		 chunks.push_back(std::unique_ptr<char[]>(new char[chunksize]));
+		 chunksizes.push_back(chunksize);
+		}
+	 void *p = chunks[chunk].get() + used;
+	 used += size;
+	 return p;
+	}
+
+	void deallocate(void *p, std::size_t bytes)
+	{
+	 std::size_t size;
+	 unsigned int c = sizeClass(bytes, size);
+	 *static_cast<void **>(p) = freelist[c];
+	 freelist[c] = p;
+	}
+
+	// Forgets every block, in constant time. Nothing that was allocated from the arena can be used (or given back) after this.
+	void reset()
+	{
+	 chunk = 0;
+	 used = 0;
+	 std::fill(freelist, freelist + classes, nullptr);
+	}
+
+ private:
+	static const std::size_t granule = 16; // every block is a multiple of this, so they're all aligned like "new" aligns them.
+	static const unsigned int smallclasses = 64; // blocks up to 64 granules are rounded up to a granule, bigger ones to a power of 2.
+	static const unsigned int classes = smallclasses + 64;
+	static const std::size_t firstchunk = 64 * 1024;
+
+	static unsigned int sizeClass(std::size_t bytes, std::size_t &size)
+	{
+		if (bytes <= smallclasses * granule)
+		{
+		 unsigned int c = (unsigned int)((bytes + granule - 1) / granule);
+		 size = (c == 0 ? granule : c * granule);
+		 return c;
+		}
+	 unsigned int c = smallclasses;
+	 size = smallclasses * granule;
+		while (size < bytes)
+		{
+		 size *= 2;
+		 c++;
+		}
+	 return c;
+	}
+
+	std::vector<std::unique_ptr<char[]>> chunks;
+	std::vector<std::size_t> chunksizes;
+	std::size_t chunk; // the chunk blocks are being carved from, and
+	std::size_t used; // how much of it is taken.
+	void *freelist[classes];
+};
+
+// This is a HELPER class that lets the standard containers draw from a "runArena". A default constructed one uses the heap instead,
+// and that's also what a copied container gets, so a clone never draws from the arena of the algorithm it was cloned from.
+template <class T>
+class arenaAllocator
+{
+ public:
+	typedef T value_type;
+	typedef std::true_type propagate_on_container_move_assignment; // a container that's given a new, empty one takes its arena.
+	typedef std::true_type propagate_on_container_swap;
+
+ arenaAllocator() : arena(nullptr){}
+ arenaAllocator(runArena &parena) : arena(&parena){}
+	template <class U>
+ arenaAllocator(const arenaAllocator<U> &other) : arena(other.arena){}
+
+	T *allocate(std::size_t n)
+	{
+		if (arena == nullptr)
+		{return static_cast<T *>(::operator new(n * sizeof(T)));}
+	 return static_cast<T *>(arena->allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T *p, std::size_t n)
+	{
+		if (arena == nullptr)
+		{::operator delete(p);}
+		else
+		{arena->deallocate(p, n * sizeof(T));}
+	}
+
+	arenaAllocator select_on_container_copy_construction() const
+	{return arenaAllocator();}
+
+	runArena *arena;
+};
+
+template <class T, class U>
+bool operator==(const arenaAllocator<T> &a, const arenaAllocator<U> &b)
+{return a.arena == b.arena;}
+
+template <class T, class U>
+bool operator!=(const arenaAllocator<T> &a, const arenaAllocator<U> &b)
+{return a.arena != b.arena;}
+
+// The per-page state of the algorithms is kept in these, so it's drawn from their arenas.
+template <class Value>
+using pageMap = std::unordered_map<int, Value, std::hash<int>, std::equal_to<int>, arenaAllocator<std::pair<const int, Value>>>;
+template <class Key>
+using arenaSet = std::set<Key, std::less<Key>, arenaAllocator<Key>>;
+
+// This function starts a new run in "arena". Every container the last run left in it is emptied first (to draw from the heap,
+// where an empty container holds nothing), since the arena forgets all of its blocks at once. Then they all draw from it again.
+//================================================================================================================
+template <class... Containers>
+void restartArena(runArena &arena, Containers &... containers)
+{
+ int released[] = {0, (Containers().swap(containers), 0)...};
+ arena.reset();
+ int rebound[] = {0, (containers = Containers(arena), 0)...};
+ (void)released;
+ (void)rebound;
+}
+
+// This is a HELPER class that looks at a reference string without owning it, like a "std::vector<int>" that can't be changed.
+// The page IDs can be anywhere: in a vector, or in a trace file mapped straight into memory, so every run on the same trace
+// reads the one copy. A vector turns into a view of itself wherever one is expected.
+class traceView
+{
+ public:
+ traceView() : pages(nullptr), count(0){}
+ traceView(const int *ppages, std::size_t pcount) : pages(ppages), count(pcount){}
+ traceView(const std::vector<int> &refstr) : pages(refstr.data()), count(refstr.size()){}
+
+	const int &operator[](std::size_t i) const
+	{return pages[i];}
+
+	const int *data() const
+	{return pages;}
+
+	std::size_t size() const
+	{return count;}
+
+	bool empty() const
+	{return count == 0;}
+
+	const int *begin() const
+	{return pages;}
+
+	const int *end() const
+	{return pages + count;}
+
+ private:
+	const int *pages;
+	std::size_t count;
+};
+
+// This is a HELPER class that collects text (or bytes) to be written out all at once, instead of a little at a time.
+// Integers are formatted by hand, without going through a stream, and a double is formatted the way "std::cout" would by default.
+// "writeTo" hands all of it to the operating system in a single "write", so a big table doesn't cost a system call per line.
+class textBuffer
+{
+ public:
+	textBuffer &operator<<(const std::string &value)
+	{
+	 text.append(value);
+	 return *this;
+	}
+
+	textBuffer &operator<<(const char *value)
+	{
+	 text.append(value);
+	 return *this;
+	}
+
+	textBuffer &operator<<(char value)
+	{
+	 text.push_back(value);
+	 return *this;
+	}
+
+	textBuffer &operator<<(const textBuffer &other)
+	{
+	 text.append(other.text);
+	 return *this;
+	}
+
+	textBuffer &operator<<(int value)
+	{return appendSigned(value);}
+
+	textBuffer &operator<<(long value)
+	{return appendSigned(value);}
+
+	textBuffer &operator<<(long long value)
+	{return appendSigned(value);}
+
+	textBuffer &operator<<(unsigned int value)
+	{return appendUnsigned(value);}
+
+	textBuffer &operator<<(unsigned long value)
+	{return appendUnsigned(value);}
+
+	textBuffer &operator<<(unsigned long long value)
+	{return appendUnsigned(value);}
+
+	textBuffer &operator<<(double value) // "%g" is what a stream does with its default precision of 6.
+	{
+	 char digits[32];
+	 int length = std::snprintf(digits, sizeof(digits), "%g", value);
+	 text.append(digits, (std::size_t)std::max(0, length));
+	 return *this;
+	}
+
+	textBuffer &appendHex(std::uint64_t value) // lower case, without a "0x" or leading zeros, like "std::hex".
+	{
+	 char digits[16];
+	 char *p = digits + sizeof(digits);
+		do
+		{
+		 *--p = "0123456789abcdef"[value & 15];
+		 value >>= 4;
+		}
+		while (value != 0);
+	 text.append(p, digits + sizeof(digits));
+	 return *this;
+	}
+
+	textBuffer &appendBytes(const void *data, std::size_t size) // for binary output, stored as it is in memory.
+	{
+	 text.append(static_cast<const char *>(data), size);
+	 return *this;
+	}
+
+	void reserve(std::size_t size)
+	{text.reserve(size);}
+
+	std::size_t size() const
+	{return text.size();}
+
+	void clear() // keeps the memory, for the next text.
+	{text.clear();}
+
+	const std::string &str() const
+	{return text;}
+
+	// Writes everything to "file" in one call (more only if the system takes less than it was given, like a full pipe).
+	// Whatever "file" (and "std::cout", when it's standard output) already had waiting goes first. Returns 0 if all of it was written.
+	int writeTo(std::FILE *file) const
+	{
+		if (file == stdout)
+		{std::cout.flush();}
+	 std::fflush(file);
+#if defined(_WIN32)
+	 return (std::fwrite(text.data(), 1, text.size(), file) == text.size() ? 0 : 1);
+#else
+	 int fd = fileno(file);
+	 const char *p = text.data();
+	 std::size_t left = text.size();
+		while (left > 0)
+		{
+		 ssize_t count = ::write(fd, p, left);
+			if (count < 0)
+			{
+				if (errno == EINTR)
+				{continue;}
+			 return 1;
+			}
+		 p += count;
+		 left -= (std::size_t)count;
+		}
+	 return 0;
+#endif
+	}
+
+ private:
+	textBuffer &appendSigned(long long value)
+	{
+		if (value < 0)
+		{
+		 text.push_back('-');
+		 return appendUnsigned(0ull - (unsigned long long)value);
+		}
+	 return appendUnsigned((unsigned long long)value);
+	}
+
+	textBuffer &appendUnsigned(unsigned long long value)
+	{
+	 char digits[20];
+	 char *p = digits + sizeof(digits);
+		do
+		{
+		 *--p = (char)('0' + value % 10);
+		 value /= 10;
+		}
+		while (value != 0);
+	 text.append(p, digits + sizeof(digits));
+	 return *this;
+	}
+
+	std::string text;
+};
+
+// This is the BASE/PARENT class where most of the data members for each algorithm are stored.
+// It's best not to change anything in this class, as it's what all objects rely on for their functionality!
+class algorithmType
+{
+	private:              // it's best practice to declare member variables here, directly in the private section of object.
+		std::string name; // Initialize all non-static variables in initialization list and all static variables directly below object.
+		unsigned int row; // Row of each objects' two dimensional, algorithm vector. Unknown until the end of each calculation.
+		unsigned int miss; // Variable that stores each page fault that's found.
+		unsigned int hit; // Variable that stores each reference that was already in the cache.
+		bool snapshots; // When false (the default), this is a "stats-only" run: only the counts are kept and "alg" stays empty.
+	    unsigned int myid; // "myid" assigns each object created with it's own identification number (starts at 1).
+		unsigned int frame; // Keeps track of the number of frames. Stored as a column. Per object, so objects can run side by side with different sizes.
+		// Set as static because only one instance is to be used for all objects.
+		// Atomic, because objects may be created (cloned) from several threads at once.
+		static std::atomic<unsigned int> maxid; // Ensures if an object is deleted that no identical id is assigned to a new object.
+		static std::atomic<unsigned int> numobj; // Keeps track of how many objects of this class were created.
+		std::vector<int> currentcashline;
+		snapshotBuffer alg;
+		std::shared_ptr<algorithmObserver> observer; // Optional. Told about every hit, page fault and eviction.
+		std::shared_ptr<const pageInterner> pagenames; // Optional. When the page IDs were interned, the addresses they stand for.
+		runArena arena; // The state of each run of the algorithm comes from here. Not copied by "clone"; a copy starts with an empty one.
+#ifdef PAGE_REPLACE_STATS
+		algorithmStats stats; // of the last "measureAlgorithm". Not copied by "clone"; a copy hasn't been measured yet.
+#endif
+
+	public:
+	    algorithmType() : algorithmType("<N/A>"){} // Delegating constructor (C++11 feature).
+		algorithmType(std::string pname) : name(pname), row(0), miss(0), hit(0), snapshots(false), frame(0) // never rely on non-member functions to initialize member variables.
+		{
+		 numobj++; // static variables were already initialized below this object, so now they can modify their values.
+		 myid = ++maxid; // this non-static member variable can't be initialized in initialization list because "maxid" is not allowed there.
+		}
+
+		// Copy constructor, used by "clone". The copy gets everything, including the frame size, except the original's I.D.
+		algorithmType(const algorithmType &other) : name(other.name), row(other.row), miss(other.miss), hit(other.hit), snapshots(other.snapshots),
+		 frame(other.frame), currentcashline(other.currentcashline), alg(other.alg), observer(other.observer), pagenames(other.pagenames)
+		{
+		 numobj++;
+		 myid = ++maxid;
+		}
+
+		algorithmType &operator=(const algorithmType &) = delete; // Every object keeps its own I.D., so objects are cloned, never assigned.
+
+		// Destructor.
+		// It's good practice to make the destructor virtual in the case that a pointer object is destroyed,
+		// there is no undefined behavior.
+		virtual ~algorithmType() 
+		{
+			if (numobj > 0)
+			{numobj--;}
+		}
+
+		// Pure virtual function that NEEDS to exist within every object of this class, as every object of this
+		// class has that member function called for it automatically. Plus, without it, there would be nothing to display!
+		virtual void calculateAlgorithm(const int &refstrcount, const traceView &refstr) = 0;
+
+		// Calls "calculateAlgorithm". When built with PAGE_REPLACE_STATS, it's also measured: how long it took, its frame searches
+		// and (on Linux) the hardware counters, on top of the counts taken as it runs. Everything that runs a whole reference string calls this.
+		virtual void measureAlgorithm(const int &refstrcount, const traceView &refstr) final
+		{
+#ifdef PAGE_REPLACE_STATS
+		 stats = algorithmStats();
+		 stats.instrumented = true;
+		 unsigned long long lookups = framelookups;
+		 unsigned long long probes = frameprobes;
+#ifdef __linux__
+		 hardwareCounters counters;
+		 counters.start();
+#endif
+		 std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#endif
+		 calculateAlgorithm(refstrcount, refstr);
+#ifdef PAGE_REPLACE_STATS
+		 stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+#ifdef __linux__
+		 counters.stop(stats);
+#endif
+		 stats.lookups = framelookups - lookups;
+		 stats.probes = frameprobes - probes;
+#endif
+		}
+
+		// Pure virtual function that returns a new copy of the object, with its own I.D. Used to run the same algorithm
+		// more than once at the same time (with different frame sizes, or on different threads) without sharing anything.
+		virtual std::shared_ptr<algorithmType> clone() const = 0;
+
+		// Returns a copy of the object, like "clone", that will only ever be run with "frames" frames. An algorithm that has a
+		// "Simulator" version overrides this to return one built for that exact number of frames. Every other algorithm just clones itself.
+		virtual std::shared_ptr<algorithmType> specialize(unsigned int /*frames*/) const
+		{return clone();}
+
+		// Streaming. An "online" algorithm (one that never looks ahead, so not "Opt") can also be given one page at a time, so a reference
+		// string of any length can be run without ever being stored. "startStream" empties the cache and the counts, then "access" takes
+		// each page and returns true on a hit. Only algorithms that say they're "getStreamable" can do this; see "onlineAlgorithm".
+		virtual bool getStreamable ()
+		{return false;}
+
+		virtual void startStream (){}
+
+		virtual bool access (int /*page*/)
+		{return false;}
+
+		virtual void finishStream (){} // called once the stream has ended, for an algorithm that decides each reference later than it's given.
+
+		virtual unsigned long long getUndecided () // how many of the pages "access" was given haven't been decided yet (a hit or a page fault).
+		{return 0;}
+
+		virtual void setMiss (unsigned int smiss) final
+		{miss = smiss;}
+
+		virtual void setHit (unsigned int shit) final
+		{hit = shit;}
+
+		// Snapshot capture is opt-in. Without it, memory used by a calculation no longer grows with each page fault.
+		virtual void setSnapshotCapture (bool ssnapshots) final
+		{snapshots = ssnapshots;}
+
+		virtual void setObserver (std::shared_ptr<algorithmObserver> sobserver) final
+		{observer = sobserver;}
+
+		// Once set, pages are displayed as the addresses they were interned from, instead of as their IDs.
+		virtual void setPageNames (std::shared_ptr<const pageInterner> spagenames) final
+		{pagenames = spagenames;}
+
+		// The "final" specifier (along with the needed "virtual" keyword) work together to ensure these functions are NEVER overridden!
+	    virtual void setRow (unsigned int srow) final
+		{row = srow;}
+
+		// Returning member by reference.
+		// This breaks encapsulation, but it saves space and it's the most important member, which defines the use of this entire program.
+		virtual snapshotBuffer &setVector () final
+		{return alg;}
+
+		virtual void setFrameFinalSize (unsigned int sframe) final
+		{frame = sframe;}
+
+		virtual std::vector<int> &setCurrentCacheLine () final
+		{return currentcashline;}
+
+		virtual unsigned int getFrameFinalSize () final
+		{return frame;}
+
+		virtual unsigned int getMiss () final
+		{return miss;}
+
+		virtual unsigned int getHit () final
+		{return hit;}
+
+		virtual bool getSnapshotCapture () final
+		{return snapshots;}
+
+		virtual bool getObserved () final // true if an observer is set.
+		{return (bool)observer;}
+
+		virtual algorithmStats getStats () final // only the hits and page faults, unless built with PAGE_REPLACE_STATS.
+		{
+		 algorithmStats current;
+#ifdef PAGE_REPLACE_STATS
+		 current = stats;
+#endif
+		 current.hits = hit;
+		 current.misses = miss;
+		 return current;
+		}
+
+		virtual unsigned int getMyId () final // Every object created will have it's own unique I.D., accessible to view via this method.
+		{return myid;}
+
+		virtual const std::string &getName() final
+		{return name;}
+
+		virtual unsigned int getRow () final
+		{return row;}
+
+		virtual const snapshotBuffer &getVector () final
+		{return alg;}
+		
+		static unsigned int static_getNumObj () // This function is static so the number of objects that exist can be displayed without the need of any one specific object.
+		{return numobj;}
+
+		virtual void clearAlg () final // This clears the buffer's contents and size to zero.
+		{alg.clear();}
+
+		virtual runArena &getArena () final // for the derived classes' per-run state, which they restart at the start of every run.
+		{return arena;}
+
+		// These are called by every "calculateAlgorithm" instead of changing the counts directly, so the observer (if any) hears about it.
+		virtual void pageHit (int position, int page) final
+		{
+		 hit++;
+			if (observer)
+			{observer->onHit(*this, position, page);}
+		}
+
+		virtual void pageMiss (int position, int page) final
+		{
+		 miss++;
+			if (observer)
+			{observer->onMiss(*this, position, page);}
+		}
+
+		virtual void pageEvict (int position, unsigned int evictframe, int evicted, int page) final
+		{
+#ifdef PAGE_REPLACE_STATS
+		 stats.evictions++;
+#endif
+			if (observer)
+			{observer->onEvict(*this, position, evictframe, evicted, page);}
+		}
+
+		virtual void countEvictions (unsigned long long count) final // evictions made without calling "pageEvict", when nothing was listening.
+		{
+#ifdef PAGE_REPLACE_STATS
+		 stats.evictions += count;
+#else
+		 (void)count;
+#endif
+		}
+
+		virtual void addCacheLine () final // Called once the current cache line is finished. Only copied when snapshots are being captured.
+		{
+		 row++;
+			if (snapshots)
+			{
+			 alg.push_back(currentcashline);
+#ifdef PAGE_REPLACE_STATS
+			 stats.snapshotbytes += currentcashline.size() * sizeof(int);
+#endif
+			}
+		}
+
+		// All 3 algorithms can be displayed in the same manner using this member function. If not, override it in derived class
+		// (and call this one first, for the table). It only adds to "out", so several algorithms can be rendered at once, on threads of their own.
+		virtual void renderAlgorithm(textBuffer &out)
+		{
+		 out << name << " page faults: " << getMiss() << "\n";
+			if (getVector().empty()) // stats-only run, so there is no table to display.
+			{
+			 out << name << " page hits: " << getHit();
+			 return;
+			}
+		 const snapshotBuffer &table = getVector();
+		 // getFrameFinalSize() doesn't account for the reference string possibly not having as many unique numbers
+		 // as there are frames, which was calculated in the 'getInput' function from the user's input.
+		 unsigned int lines = std::min(table.width(), getFrameFinalSize());
+		 out.reserve(out.size() + (std::size_t)lines * table.size() * (pagenames ? 12 : 4));
+			for (unsigned int a = 0; a < lines; a++) // this display method displays this multidimensional vector inversely to match textbooks etc.
+			{
+				if (a > 0)
+				{out << "\n";}
+				for (std::size_t i = 0; i < table.size(); i++) // 'table.size()' is the same as 'getRow()'.
+				{
+					if (i > 0)
+					{out << ' ';}
+					if (pagenames)
+					{(out << "0x").appendHex(pagenames->getAddress(table[i][a]));}
+					else
+					{out << table[i][a];}
+				}
+			}
+		}
+
+		virtual void displayAlgorithm() final // Renders the algorithm, and writes it out all at once.
+		{
+		 textBuffer out;
+		 renderAlgorithm(out);
+		 out.writeTo(stdout);
+		}
+
+		virtual std::shared_ptr<const pageInterner> getPageNames () final
+		{return pagenames;}
+
+		virtual int fillFirstCacheLine(const traceView &refstr, const int &refstrcount) final
+		{
+		 setCurrentCacheLine().clear(); // its memory is kept for the next run.
+		 int currentrefstr = 0;
+			for (int i = 0; i < refstrcount; i++) // we're looping through entire reference string just in case there are repeating numbers at beginning
+			{
+				if (findFrame(setCurrentCacheLine().data(), setCurrentCacheLine().size(), refstr[i]) == setCurrentCacheLine().size()) // As long as no duplicate pages were found in the first frame...
+				{
+				 pageMiss(i, refstr[i]); // page miss, then decide what to do next depending on the algorithm.
+				 setCurrentCacheLine().push_back(refstr[i]);
+				}
+				else
+				{pageHit(i, refstr[i]);}
+				if (setCurrentCacheLine().size() >= getFrameFinalSize() || (i + 1 >= refstrcount)) // create first line of cache now that all pages have been added to all frames.
+				{
+				 currentrefstr = i + 1;
+				 addCacheLine(); // add finished frames to the cache.
+				 break;
+				}
+			}
+		 return currentrefstr;
+		}
+
+};
+
+// Initializing the static variables, but this is, and can ONLY be initialized once, which it is here.
+std::atomic<unsigned int> algorithmType :: numobj(0); // No objects of this class have been created yet.
+std::atomic<unsigned int> algorithmType :: maxid(0); // No objects of this class have been created yet.
+
+// This is a HELPER class (not an algorithm) holding one value per frame for "Simulator" and its policies.
+// With a fixed number of frames it's a plain array, so loops over it can be unrolled. With "FrameCount" 0 it's sized at runtime.
+template <class T, unsigned int FrameCount>
+class frameStorage
+{
+ public:
+	void resize(unsigned int){}
+	unsigned int size() const
+	{return FrameCount;}
+	T *data()
+	{return values;}
+	T &operator[](unsigned int c)
+	{return values[c];}
+ private:
+	T values[FrameCount];
+};
+
+template <class T>
+class frameStorage<T, 0>
+{
+ public:
+	void resize(unsigned int count)
+	{values.assign(count, T());}
+	unsigned int size() const
+	{return (unsigned int)values.size();}
+	T *data()
+	{return values.data();}
+	T &operator[](unsigned int c)
+	{return values[c];}
+ private:
+	std::vector<T> values;
+};
+
+// These are the policies "Simulator" can be built with. A policy only decides which frame is replaced; "Simulator" does everything else.
+// Each one has: "reset(frames)" before the first reference after the first cache line, "hit(frame, position)" when a page is found,
+// "victim()" on a page fault to pick the frame to replace, and "load(frame, position)" once the new page is in it.
+// "maxframes" is the most frames a policy is still faster than its own class with (beyond it, a linear search or scan costs too much).
+// They give exactly the same results as "Fifo", "Lru" and "Clock".
+template <unsigned int FrameCount>
+class fifoPolicy
+{
+ public:
+	static const unsigned int maxframes = UINT_MAX; // "Fifo" searches the frames linearly too.
+	void reset(unsigned int pframes)
+	{
+	 frames = (FrameCount != 0 ? FrameCount : pframes);
+	 next = 0;
+	}
+	void hit(unsigned int, int){}
+	unsigned int victim()
+	{return next;}
+	void load(unsigned int c, int)
+	{next = ((c + 1 < frames) ? c + 1 : 0);}
+ private:
+	unsigned int frames;
+	unsigned int next; // the frame that was loaded the longest time ago.
+};
+
+template <unsigned int FrameCount>
+class lruPolicy
+{
+ public:
+	static const unsigned int maxframes = 16;
+	void reset(unsigned int pframes)
+	{
+	 lastuse.resize(pframes);
+		for (unsigned int c = 0; c < lastuse.size(); c++) // like "Lru", the first cache line starts out in the order its pages were added.
+		{lastuse[c] = (int)c - (int)lastuse.size();}
+	}
+	void hit(unsigned int c, int position)
+	{lastuse[c] = position;}
+	unsigned int victim()
+	{
+	 unsigned int oldest = 0;
+		for (unsigned int c = 1; c < lastuse.size(); c++)
+		{oldest = (lastuse[c] < lastuse[oldest] ? c : oldest);}
+	 return oldest;
+	}
+	void load(unsigned int c, int position)
+	{lastuse[c] = position;}
+ private:
+	frameStorage<int, FrameCount> lastuse; // index in the reference string of each frame's last use.
+};
+
+template <unsigned int FrameCount>
+class clockPolicy
+{
+ public:
+	static const unsigned int maxframes = 512;
+	void reset(unsigned int pframes)
+	{
+	 referenced.resize(pframes);
+		for (unsigned int c = 0; c < referenced.size(); c++)
+		{referenced[c] = 1;}
+	 hand = 0;
+	}
+	void hit(unsigned int c, int)
+	{referenced[c] = 1;}
+	unsigned int victim()
+	{
+		while (referenced[hand]) // second chance: clear every bit that's passed.
+		{
+		 referenced[hand] = 0;
+		 hand = ((hand + 1 < referenced.size()) ? hand + 1 : 0);
+		}
+	 return hand;
+	}
+	void load(unsigned int c, int)
+	{
+	 referenced[c] = 1;
+	 hand = ((c + 1 < referenced.size()) ? c + 1 : 0);
+	}
+ private:
+	frameStorage<unsigned char, FrameCount> referenced;
+	unsigned int hand;
+};
+
+// This is an INTERMEDIATE class: an algorithm built from a policy at compile time, instead of a class of its own.
+// Everything a policy does is inlined into one loop, nothing in the loop is virtual, and when only the counts are wanted
+// (no snapshots, no observer) the counts are kept in local variables and stored once at the end.
+// With a "FrameCount" other than 0 it only runs with exactly that many frames, and the frame search and the policy's
+// loops over the frames are unrolled. "makeSimulator" picks the right one for a number of frames.
+template <template <unsigned int> class Policy, unsigned int FrameCount = 0>
+class Simulator : public algorithmType
+{
+ private:
+	Policy<FrameCount> policy;
+	frameStorage<int, FrameCount> frames;
+
+	unsigned int find(int page)
+	{
+		if (FrameCount != 0 && FrameCount < 16) // a handful of frames are faster to compare one by one, fully unrolled.
+		{
+		 unsigned int c = 0;
+			while (c < frames.size() && frames[c] != page)
+			{c++;}
+		 countFrameSearch(c, frames.size());
+		 return c;
+		}
+	 return (unsigned int)findFrame(frames.data(), frames.size(), page);
+	}
+
+	template <bool Reporting>
+	void run(int start, const int &refstrcount, const traceView &refstr)
+	{
+	 unsigned int misses = 0, hits = 0;
+		for (int i = start; i < refstrcount; i++)
+		{
+		 int page = refstr[i];
+		 unsigned int c = find(page);
+			if (c < frames.size())
+			{
+			 policy.hit(c, i);
+				if (Reporting)
+				{pageHit(i, page);}
+				else
+				{hits++;}
+			 continue;
+			}
+		 c = policy.victim();
+			if (Reporting)
+			{
+			 pageMiss(i, page);
+			 pageEvict(i, c, frames[c], page);
+			 setCurrentCacheLine()[c] = page;
+			}
+			else
+			{misses++;}
+		 frames[c] = page;
+		 policy.load(c, i);
+			if (Reporting)
+			{addCacheLine();}
+		}
+		if (!Reporting)
+		{
+		 setMiss(getMiss() + misses);
+		 setHit(getHit() + hits);
+		 setRow(getRow() + misses);
+		 countEvictions(misses); // every page fault after the first cache line evicts something.
+		}
+	}
+
+ public:
+ Simulator(){} // Default Constructor
+ Simulator(std::string pname) : algorithmType(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+ Simulator(const algorithmType &other) : algorithmType(other){} // Takes over another algorithm's name, settings and observer.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Simulator>(*this);}
+
+	virtual void calculateAlgorithm(const int &refstrcount, const traceView &refstr) override // Required for all derived classes of "algorithmType".
+	{
+	 int start = fillFirstCacheLine(refstr, refstrcount);  // fill in first cache line of frames
+		if (start >= refstrcount) // the first cache line used up the whole reference string (it may not even be full).
+		{return;}
+		if (FrameCount != 0 && setCurrentCacheLine().size() != FrameCount) // the frame size was changed after it was built.
+		{throw std::invalid_argument(getName() + " was built for " + std::to_string(FrameCount) + " frames, not " + std::to_string(setCurrentCacheLine().size()));}
+	 frames.resize((unsigned int)setCurrentCacheLine().size());
+		for (unsigned int c = 0; c < frames.size(); c++)
+		{frames[c] = setCurrentCacheLine()[c];}
+	 policy.reset(frames.size());
+		if (getSnapshotCapture() || getObserved())
+		{run<true>(start, refstrcount, refstr);}
+		else
+		{run<false>(start, refstrcount, refstr);}
+	}
+
+};
+
+// This function returns a "Simulator" for "Policy" that takes over everything from "other", built for exactly "frames" frames
+// when there's a fixed size version for it, and sized at runtime otherwise.
+//================================================================================================================
+template <template <unsigned int> class Policy>
+std::shared_ptr<algorithmType> makeSimulator(const algorithmType &other, unsigned int frames)
+{
+	switch (frames)
+	{
+	 case 1: return std::make_shared<Simulator<Policy, 1>>(other);
+	 case 2: return std::make_shared<Simulator<Policy, 2>>(other);
+	 case 3: return std::make_shared<Simulator<Policy, 3>>(other);
+	 case 4: return std::make_shared<Simulator<Policy, 4>>(other);
+	 case 5: return std::make_shared<Simulator<Policy, 5>>(other);
+	 case 6: return std::make_shared<Simulator<Policy, 6>>(other);
+	 case 7: return std::make_shared<Simulator<Policy, 7>>(other);
+	 case 8: return std::make_shared<Simulator<Policy, 8>>(other);
+	 case 16: return std::make_shared<Simulator<Policy, 16>>(other);
+	 case 32: return std::make_shared<Simulator<Policy, 32>>(other);
+	 default: return std::make_shared<Simulator<Policy, 0>>(other);
+	}
+}
+
+// This is an INTERMEDIATE class for every "online" algorithm: one that decides what to do with each reference only from what's already
+// happened. It runs the algorithm both on a whole reference string ("calculateAlgorithm") and one page at a time ("access"),
+// with exactly the same results, by handing each reference to "Derived" (the algorithm itself, e.g. "class Lru : public onlineAlgorithm<Lru>"),
+// which only has to provide:
+//  "resetState()", to set up its own state, empty, for "getFrameFinalSize()" frames,
+//  "firstReference(position, page)", for each reference while the first cache line is filled (the page is already loaded here, if it's new),
+//  "firstLineDone()", once the first cache line is finished, and
+//  "nextReference(position, page)", for every reference after that, which returns true on a hit.
+// These are called directly, not virtually, so they're inlined into the loop.
+template <class Derived>
+class onlineAlgorithm : public algorithmType
+{
+ private:
+	unsigned long long streamposition; // how many pages "access" was given since "startStream".
+
+	bool fill(int position, int page) // one reference while the first cache line is being filled.
+	{
+	 Derived &self = static_cast<Derived &>(*this);
+	 std::vector<int> &cacheline = setCurrentCacheLine();
+	 bool found = (findFrame(cacheline.data(), cacheline.size(), page) != cacheline.size()); // the first cache line, just like "fillFirstCacheLine".
+		if (found)
+		{pageHit(position, page);}
+		else
+		{
+		 pageMiss(position, page);
+		 cacheline.push_back(page);
+		}
+	 self.firstReference(position, page);
+		if (cacheline.size() >= getFrameFinalSize())
+		{
+		 addCacheLine(); // add finished frames to the cache.
+		 self.firstLineDone();
+		}
+	 return found;
+	}
+
+ public:
+ onlineAlgorithm() : streamposition(0){} // Default Constructor
+ onlineAlgorithm(std::string pname) : algorithmType(pname), streamposition(0){} // Overloaded Constructor.
+
+	virtual void calculateAlgorithm(const int &refstrcount, const traceView &refstr) override // Required for all derived classes of "algorithmType".
+	{
+	 Derived &self = static_cast<Derived &>(*this);
+	 setCurrentCacheLine().clear();
+	 self.resetState();
+	 int i = 0;
+		for (; i < refstrcount && setCurrentCacheLine().size() < getFrameFinalSize(); i++)
+		{fill(i, refstr[i]);}
+		for (; i < refstrcount; i++)
+		{self.nextReference(i, refstr[i]);}
+		if (refstrcount > 0 && setCurrentCacheLine().size() < getFrameFinalSize()) // the reference string ended before the first cache line was full.
+		{
+		 addCacheLine();
+		 self.firstLineDone();
+		}
+	}
+
+	virtual bool getStreamable () override
+	{return true;}
+
+	virtual void startStream () override
+	{
+	 clearAlg();
+	 setRow(0);
+	 setMiss(0);
+	 setHit(0);
+	 setCurrentCacheLine().clear();
+	 streamposition = 0;
+	 static_cast<Derived &>(*this).resetState();
+	}
+
+	virtual bool access (int page) override
+	{
+	 int position = (int)(streamposition++ & INT_MAX); // positions wrap around after INT_MAX, since a stream can be longer than that.
+		if (setCurrentCacheLine().size() < getFrameFinalSize())
+		{return fill(position, page);}
+	 return static_cast<Derived &>(*this).nextReference(position, page);
+	}
+
+};
+
+// This is a DERIVED/CHILD class, signified by inheriting from class "algorithmType".
+// For every new algorithm added, a new derived class that inherits "algorithmType" needs to be added.
+// The only entity that needs to be added to these classes is the member function "calculateAlgorithm".
+// This is because calculating each algorithm is unique to each algorithm. And any other unique functionality
+// that these algorithms have needs to be added to it's specific (derived) class.
+class Fifo : public onlineAlgorithm<Fifo>
+{
+ private:
+	unsigned int fcount; // keeps track of index of the first page added to cache.
+
+ public:
+ Fifo(){} // Default Constructor
+ Fifo(std::string pname) : onlineAlgorithm<Fifo>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Fifo>(*this);}
+
+	virtual std::shared_ptr<algorithmType> specialize(unsigned int frames) const override // the same algorithm, compiled for "frames" frames.
+	{return (frames <= fifoPolicy<0>::maxframes ? makeSimulator<fifoPolicy>(*this, frames) : clone());}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{fcount = 0;}
+
+	void firstReference(int, int){}
+
+	void firstLineDone(){}
+
+	bool nextReference(int i, int page)
+	{
+		if (findFrame(setCurrentCacheLine().data(), setCurrentCacheLine().size(), page) == setCurrentCacheLine().size()) // If nothing in current cache of frames matches the current element in reference string...
+		{
+		 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+		 pageEvict(i, fcount, setCurrentCacheLine()[fcount], page);
+		 setCurrentCacheLine()[fcount] = page; // replace next frame in the count with the current reference string.
+		 ((fcount + 1 < getFrameFinalSize()) ? fcount++ : fcount = 0);
+		 addCacheLine(); // add finished frames to the cache.
+		 return false;
+		}
+	 pageHit(i, page);
+	 return true;
+	}
+
+};
+
+// This is a HELPER class (not an algorithm) for keeping frames in order of recency.
+// Every node is preallocated in one vector and addressed by its frame index, so unlike "std::list" nothing is
+// allocated per reference, and moving, removing or appending a frame never needs to search for it first.
+class recencyList
+{
+ private:
+	static const unsigned int none = 0xFFFFFFFFu; // marks the end of the list in either direction.
+	struct node
+	{
+	 unsigned int prev;
+	 unsigned int next;
+	};
+	std::vector<node> pool;
+	unsigned int head; // least recently used frame.
+	unsigned int tail; // most recently used frame.
+	unsigned int count;
+
+ public:
+	recencyList() : head(none), tail(none), count(0){}
+
+	void reset(unsigned int capacity) // empties the list and makes room for frames 0 to "capacity" - 1.
+	{
+	 pool.assign(capacity, node{none, none});
+	 head = none;
+	 tail = none;
+	 count = 0;
+	}
+
+	void pushBack(unsigned int c)
+	{
+	 count++;
+	 pool[c].prev = tail;
+	 pool[c].next = none;
+		if (tail != none)
+		{pool[tail].next = c;}
+		else
+		{head = c;}
+	 tail = c;
+	}
+
+	void remove(unsigned int c)
+	{
+	 count--;
+		if (pool[c].prev != none)
+		{pool[pool[c].prev].next = pool[c].next;}
+		else
+		{head = pool[c].next;}
+		if (pool[c].next != none)
+		{pool[pool[c].next].prev = pool[c].prev;}
+		else
+		{tail = pool[c].prev;}
+	}
+
+	void moveToBack(unsigned int c)
+	{
+		if (c != tail)
+		{
+		 remove(c);
+		 pushBack(c);
+		}
+	}
+
+	unsigned int front() const
+	{return head;}
+
+	bool empty() const
+	{return head == none;}
+
+	unsigned int size() const
+	{return count;}
+};
+
+class Lru : public onlineAlgorithm<Lru>
+{
+ private:
+	// This algorithm still uses the "stack" method, but the stack holds frame indexes instead of pages, and a page -> frame index
+	// replaces both searches, so a hit or a page fault takes constant time no matter how many frames there are.
+	recencyList lst;
+	pageMap<unsigned int> pageframe; // page -> index of the frame that currently holds it.
+
+ public:
+ Lru(){} // Default Constructor
+ Lru(std::string pname) : onlineAlgorithm<Lru>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Lru>(*this);}
+
+	virtual std::shared_ptr<algorithmType> specialize(unsigned int frames) const override // the same algorithm, compiled for "frames" frames.
+	{return (frames <= lruPolicy<0>::maxframes ? makeSimulator<lruPolicy>(*this, frames) : clone());}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 lst.reset(getFrameFinalSize());
+	 restartArena(getArena(), pageframe);
+	 pageframe.reserve(getFrameFinalSize());
+	}
+
+	void firstReference(int, int page) // the first cache line starts out in the order its pages were added.
+	{
+	 unsigned int c = (unsigned int)pageframe.size();
+		if (pageframe.emplace(page, c).second)
+		{lst.pushBack(c);}
+	}
+
+	void firstLineDone(){}
+
+	bool nextReference(int i, int page)
+	{
+	 pageMap<unsigned int>::iterator itr_frame = pageframe.find(page);
+		if (itr_frame == pageframe.end()) // If nothing in current cache of frames matches the current element in reference string...
+		{
+		 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+		 unsigned int c = lst.front(); // the least recently used frame is replaced.
+		 pageEvict(i, c, setCurrentCacheLine()[c], page);
+		 pageframe.erase(setCurrentCacheLine()[c]);
+		 pageframe.emplace(page, c);
+		 setCurrentCacheLine()[c] = page;
+		 lst.moveToBack(c);
+		 addCacheLine(); // add finished frames to the cache.
+		 return false;
+		}
+	 pageHit(i, page);
+	 lst.moveToBack(itr_frame->second);
+	 return true;
+	}
+ 
+};
+
+// This function makes one backward pass over the reference string, and stores the index of the next occurrence of each element in "nextuse".
+// Because refstrcount is always going to be 1 element passed the last element in refstr, "refstrcount" means "never used again".
+// Once it's done, "firstuse" holds the index of the first occurrence of every page.
+//================================================================================================================
+template <class Map>
+void buildNextUse(const int &refstrcount, const traceView &refstr, std::vector<int> &nextuse, Map &firstuse)
+{
+ nextuse.resize(refstrcount);
+ firstuse.clear();
+	for (int i = refstrcount - 1; i >= 0; i--)
+	{
+	 typename Map::iterator itr_pos = firstuse.find(refstr[i]);
+		if (itr_pos == firstuse.end())
+		{
+		 nextuse[i] = refstrcount;
+		 firstuse.emplace(refstr[i], i);
+		}
+		else
+		{
+		 nextuse[i] = itr_pos->second;
+		 itr_pos->second = i;
+		}
+	}
+}
+
+// This is an INTERMEDIATE class shared by both "Opt" and "Opt_Fifo", which only differ in how they break ties.
+// Instead of searching the rest of the reference string for every frame on every page fault, one backward pass
+// stores the index of the next occurrence of each element, and the frames are kept in an ordered set keyed by their next use.
+// This makes each reference O(log frames) instead of O(frames * remaining reference string).
+class OptEngine : public algorithmType
+{
+ private:
+	bool fifotiebreak; // false = "Opt" (first frame with no future use is replaced), true = "Opt_Fifo" (oldest first occurrence is replaced).
+	// Each frame is stored as (next use, tie breaker, frame index). The LAST element of the set is always the frame to be replaced.
+	// Every page in the cache line is unique, so two frames can only share a next use when neither is used again ("refstrcount").
+	typedef std::tuple<int, int, unsigned int> frameKey;
+	// The state of one calculation. Kept between them, so a calculation reuses the memory of the last one.
+	std::vector<int> nextuse;
+	pageMap<int> firstuse; // "Opt_Fifo" breaks ties with the first occurrence of each page.
+	pageMap<unsigned int> pageframe; // page -> index of the frame that currently holds it.
+	std::vector<frameKey> framekey;
+	arenaSet<frameKey> nextqueue;
+
+ public:
+ OptEngine(std::string pname, bool pfifotiebreak) : algorithmType(pname), fifotiebreak(pfifotiebreak){}
+
+	virtual void calculateAlgorithm(const int &refstrcount, const traceView &refstr) override // Required for all derived classes of "algorithmType".
+	{
+	 restartArena(getArena(), firstuse, pageframe, nextqueue);
+	 framekey.clear();
+	 buildNextUse(refstrcount, refstr, nextuse, firstuse);
+	 int start = fillFirstCacheLine(refstr, refstrcount);  // fill in first cache line of frames
+		for (unsigned int c = 0; c < setCurrentCacheLine().size(); c++)
+		{
+		 pageframe.emplace(setCurrentCacheLine()[c], c);
+		 framekey.push_back(frameKey(refstrcount, 0, c));
+		}
+		for (int i = 0; i < start; i++) // the last time each page was referenced in the first cache line decides its next use.
+		{
+		 unsigned int c = pageframe[refstr[i]];
+		 framekey[c] = frameKey(nextuse[i], (fifotiebreak ? -firstuse[refstr[i]] : -(int)c), c);
+		}
+	 nextqueue.insert(framekey.begin(), framekey.end());
+		for (int i = start; i < refstrcount; i++)
+		{
+		 pageMap<unsigned int>::iterator itr_frame = pageframe.find(refstr[i]);
+		 unsigned int c;
+			if (itr_frame == pageframe.end()) // If nothing in current cache of frames matches the current element in reference string...
+			{
+			 pageMiss(i, refstr[i]); // page miss, then decide what to do next depending on the algorithm.
+				if (!fifotiebreak && i >= (refstrcount - 1)) // at the last element of reference string... "Opt" simply replaces first element in cache line.
+				{c = 0;}
+				else
+				{c = std::get<2>(*nextqueue.rbegin());} // furthest next use, or the tie breaker when several frames are never used again.
+			 pageEvict(i, c, setCurrentCacheLine()[c], refstr[i]);
+			 pageframe.erase(setCurrentCacheLine()[c]);
+			 pageframe.emplace(refstr[i], c);
+			 setCurrentCacheLine()[c] = refstr[i];
+			 addCacheLine(); // add finished frames to the cache.
+			}
+			else
+			{
+			 pageHit(i, refstr[i]);
+			 c = itr_frame->second;
+			}
+		 nextqueue.erase(framekey[c]);
+		 framekey[c] = frameKey(nextuse[i], (fifotiebreak ? -firstuse[refstr[i]] : -(int)c), c);
+		 nextqueue.insert(framekey[c]);
+		}
+	}
+
+};
+
+class Opt : public OptEngine
+{
+ public:
+ Opt() : OptEngine("<N/A>", false){} // Default Constructor
+ Opt(std::string pname) : OptEngine(pname, false){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Opt>(*this);}
+};
+
+class Opt_Fifo : public OptEngine
+{
+ public:
+ Opt_Fifo() : OptEngine("<N/A>", true){} // Default Constructor
+ Opt_Fifo(std::string pname) : OptEngine(pname, true){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Opt_Fifo>(*this);}
+};
+
+// Belady's optimal algorithm, but only able to see "window" references ahead, like a system with a bounded queue of upcoming accesses
+// (or a stream, where the future can't be stored). The upcoming references are kept in a ring buffer, where every page chains its
+// occurrences together, so the next use of any page in the window is known at once, and updated as the window slides.
+// A page that isn't used again within the window counts as never used again, and of those the least recently used is replaced.
+// With a window as long as the reference string, it has the same page faults as "Opt" (though not always the same frames).
+// Memory only depends on the window and the number of frames.
+// Each reference is decided once "window" more have arrived, so "access" answers for the reference given "window" pages ago.
+class LookaheadOpt : public algorithmType
+{
+ private:
+	static const long long never = LLONG_MAX;
+	typedef std::tuple<long long, long long, unsigned int> frameKey; // (next use, -last use, frame index). The LAST one in "nextqueue" is replaced.
+	struct occurrences
+	{
+	 long long first; // position of the page's next use, and
+	 long long last;  // of its last use, within the window.
+	};
+	unsigned int window;
+	// The state of one calculation. It's reset at the start of every "calculateAlgorithm" (or stream).
+	std::vector<int> ring; // the reference being decided and the "window" after it, indexed by position % (window + 1).
+	std::vector<long long> ringnext; // position of the next use of the same page within the window, or "never".
+	pageMap<occurrences> inwindow;
+	long long seen; // references that have arrived, and
+	long long decided; // references that have been decided.
+	pageMap<unsigned int> pageframe; // page -> index of the frame that currently holds it.
+	std::vector<frameKey> framekey;
+	arenaSet<frameKey> nextqueue;
+	unsigned int exactfaults; // page faults of the exact "Opt" on the same references, if it's known.
+	bool hasexact;
+
+	void resetState()
+	{
+	 ring.assign((std::size_t)window + 1, 0);
+	 ringnext.assign((std::size_t)window + 1, never);
+	 restartArena(getArena(), inwindow, pageframe, nextqueue);
+	 seen = decided = 0;
+	 framekey.clear();
+	 setCurrentCacheLine().clear();
+	}
+
+	void setKey(unsigned int c, long long nextuse, long long lastuse)
+	{
+		if (c < framekey.size())
+		{nextqueue.erase(framekey[c]);}
+		else
+		{framekey.resize(c + 1);}
+	 framekey[c] = frameKey(nextuse, -lastuse, c);
+	 nextqueue.insert(framekey[c]);
+	}
+
+	bool arrive(int page) // adds a reference to the end of the window, and decides the oldest one once the window is full.
+	{
+	 long long q = seen++;
+	 std::size_t slot = (std::size_t)(q % (long long)ring.size());
+	 ring[slot] = page;
+	 ringnext[slot] = never;
+	 pageMap<occurrences>::iterator itr_occ = inwindow.find(page);
+		if (itr_occ != inwindow.end())
+		{
+		 ringnext[(std::size_t)(itr_occ->second.last % (long long)ring.size())] = q;
+		 itr_occ->second.last = q;
+		}
+		else
+		{
+		 inwindow.emplace(page, occurrences{q, q});
+		 pageMap<unsigned int>::iterator itr_frame = pageframe.find(page);
+			if (itr_frame != pageframe.end()) // a resident page that was never going to be used again, now is.
+			{setKey(itr_frame->second, q, -std::get<1>(framekey[itr_frame->second]));}
+		}
+	 return (seen - decided > (long long)window ? decide() : false);
+	}
+
+	bool decide() // decides the oldest reference in the window. Returns true on a hit.
+	{
+	 long long t = decided++;
+	 std::size_t slot = (std::size_t)(t % (long long)ring.size());
+	 int page = ring[slot];
+	 int position = (int)(t & INT_MAX); // positions wrap around after INT_MAX, since a stream can be longer than that.
+	 long long nextuse = ringnext[slot];
+		if (nextuse == never)
+		{inwindow.erase(page);}
+		else
+		{inwindow[page].first = nextuse;}
+	 pageMap<unsigned int>::iterator itr_frame = pageframe.find(page);
+		if (itr_frame != pageframe.end())
+		{
+		 pageHit(position, page);
+		 setKey(itr_frame->second, nextuse, t);
+		 return true;
+		}
+	 pageMiss(position, page); // page miss, then decide what to do next depending on the algorithm.
+	 unsigned int c;
+		if (setCurrentCacheLine().size() < getFrameFinalSize()) // the first cache line is still being filled.
+		{
+		 c = (unsigned int)setCurrentCacheLine().size();
+		 setCurrentCacheLine().push_back(page);
+		 pageframe.emplace(page, c);
+		 setKey(c, nextuse, t);
+			if (setCurrentCacheLine().size() >= getFrameFinalSize())
+			{addCacheLine();} // add finished frames to the cache.
+		 return false;
+		}
+	 c = std::get<2>(*nextqueue.rbegin()); // furthest next use, or the least recently used of the pages not used again within the window.
+	 pageEvict(position, c, setCurrentCacheLine()[c], page);
+	 pageframe.erase(setCurrentCacheLine()[c]);
+	 pageframe.emplace(page, c);
+	 setCurrentCacheLine()[c] = page;
+	 setKey(c, nextuse, t);
+	 addCacheLine(); // add finished frames to the cache.
+	 return false;
+	}
+
+	void finish() // the input has ended, so everything still in the window is decided.
+	{
+		while (decided < seen)
+		{decide();}
+		if (seen > 0 && setCurrentCacheLine().size() < getFrameFinalSize()) // the reference string ended before the first cache line was full.
+		{addCacheLine();}
+	}
+
+ public:
+ LookaheadOpt() : window(10000), exactfaults(0), hasexact(false){} // Default Constructor
+ LookaheadOpt(std::string pname, unsigned int pwindow) : algorithmType(pname), window(pwindow), exactfaults(0), hasexact(false){} // Overloaded Constructor.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<LookaheadOpt>(*this);}
+
+	virtual void calculateAlgorithm(const int &refstrcount, const traceView &refstr) override // Required for all derived classes of "algorithmType".
+	{
+	 resetState();
+		for (int i = 0; i < refstrcount; i++)
+		{arrive(refstr[i]);}
+	 finish();
+	}
+
+	virtual bool getStreamable () override
+	{return true;}
+
+	virtual void startStream () override
+	{
+	 clearAlg();
+	 setRow(0);
+	 setMiss(0);
+	 setHit(0);
+	 resetState();
+	}
+
+	virtual bool access (int page) override // true if the reference "window" pages ago was a hit.
+	{return arrive(page);}
+
+	virtual void finishStream () override
+	{finish();}
+
+	virtual unsigned long long getUndecided () override
+	{return (unsigned long long)(seen - decided);}
+
+	void setExactFaults (unsigned int sexactfaults) // the page faults "Opt" had on the same references with the same frames.
+	{
+	 exactfaults = sexactfaults;
+	 hasexact = true;
+	}
+
+	virtual void renderAlgorithm(textBuffer &out) override // The same table as every other algorithm, followed by "renderWindow".
+	{
+	 algorithmType::renderAlgorithm(out);
+	 out << "\n";
+	 renderWindow(out);
+	}
+
+	void renderWindow(textBuffer &out) // One line (without its end): the window, and how far from "Opt" it was, if that's known.
+	{
+	 out << getName() << " window: " << window << " references ahead";
+		if (hasexact)
+		{
+		 long long extra = (long long)getMiss() - exactfaults;
+		 out << ", " << extra << " page faults more than the exact optimal (" << 100.0 * extra / std::max(1u, exactfaults) << "% more)";
+		}
+	}
+};
+
+const long long LookaheadOpt :: never; // "assign" takes it by reference, so before C++17 it needs a definition too.
+
+// This is a HELPER class (not an algorithm) that packs one reference bit per frame, 64 frames to a word.
+// "findUnreferenced" is the hand of a clock: it returns the first frame from the hand onward whose bit is clear, clearing every bit
+// it passes on the way. A whole word of referenced frames is passed (and cleared) at once, so a full sweep costs frames / 64.
+class referenceBits
+{
+ public:
+	void reset(unsigned int size)
+	{
+	 bits.assign((size + 63) / 64, 0);
+	 count = size;
+	}
+
+	void set(unsigned int c)
+	{bits[c / 64] |= (1ull << (c % 64));}
+
+	void clear(unsigned int c)
+	{bits[c / 64] &= ~(1ull << (c % 64));}
+
+	bool test(unsigned int c) const
+	{return (bits[c / 64] >> (c % 64)) & 1;}
+
+	unsigned int findUnreferenced(unsigned int hand)
+	{
+		while (true) // after one full turn every bit is clear, so this always ends by the second turn.
+		{
+		 unsigned int w = hand / 64;
+		 std::uint64_t from = ~0ull << (hand % 64); // bits from the hand onward, in this word.
+			if ((w + 1) * 64 > count) // the last word may have bits past the last frame.
+			{from &= (~0ull >> ((w + 1) * 64 - count));}
+		 std::uint64_t unreferenced = ~bits[w] & from;
+			if (unreferenced != 0)
+			{
+			 unsigned int c = w * 64 + (unsigned int)__builtin_ctzll(unreferenced);
+			 bits[w] &= ~(from & ((1ull << (c % 64)) - 1)); // second chance: clear every bit that was passed.
+			 return c;
+			}
+		 bits[w] &= ~from;
+		 hand = ((w + 1) * 64 < count ? (w + 1) * 64 : 0);
+		}
+	}
+
+ private:
+	std::vector<std::uint64_t> bits;
+	unsigned int count;
+};
+
+// CLOCK (second chance). Frames are kept in a circle, like "Fifo", but every frame has a reference bit that's set whenever its page
+// is used. On a page fault, the hand skips (and clears) every frame whose bit is set, and replaces the first one that isn't.
+// A newly loaded page has its bit set, since loading it is a reference too.
+class Clock : public onlineAlgorithm<Clock>
+{
+ private:
+	referenceBits referenced;
+	pageMap<unsigned int> pageframe; // page -> index of the frame that currently holds it.
+	unsigned int hand;
+
+ public:
+ Clock(){} // Default Constructor
+ Clock(std::string pname) : onlineAlgorithm<Clock>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Clock>(*this);}
+
+	virtual std::shared_ptr<algorithmType> specialize(unsigned int frames) const override // the same algorithm, compiled for "frames" frames.
+	{return (frames <= clockPolicy<0>::maxframes ? makeSimulator<clockPolicy>(*this, frames) : clone());}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 referenced.reset(getFrameFinalSize());
+	 restartArena(getArena(), pageframe);
+	 pageframe.reserve(getFrameFinalSize());
+	 hand = 0;
+	}
+
+	void firstReference(int, int page)
+	{
+	 unsigned int c = (unsigned int)pageframe.size();
+		if (pageframe.emplace(page, c).second)
+		{referenced.set(c);}
+	}
+
+	void firstLineDone(){}
+
+	bool nextReference(int i, int page)
+	{
+	 pageMap<unsigned int>::iterator itr_frame = pageframe.find(page);
+		if (itr_frame == pageframe.end()) // If nothing in current cache of frames matches the current element in reference string...
+		{
+		 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+		 unsigned int c = referenced.findUnreferenced(hand);
+		 pageEvict(i, c, setCurrentCacheLine()[c], page);
+		 pageframe.erase(setCurrentCacheLine()[c]);
+		 pageframe.emplace(page, c);
+		 setCurrentCacheLine()[c] = page;
+		 referenced.set(c);
+		 hand = ((c + 1 < getFrameFinalSize()) ? c + 1 : 0);
+		 addCacheLine(); // add finished frames to the cache.
+		 return false;
+		}
+	 pageHit(i, page);
+	 referenced.set(itr_frame->second);
+	 return true;
+	}
+
+};
+
+// CLOCK-Pro (Jiang, Chen and Zhang, 2005). Resident pages are either "hot" or "cold", and only cold pages are replaced.
+// A cold page that's replaced stays in the clock as a non-resident "test" page for a while, and if it's used again before its test
+// period ends, it comes back hot, and the space allowed for cold pages grows. When a test period ends unused, that space shrinks.
+// Three hands go around one circular list of at most twice the number of frames:
+//  the cold hand replaces cold pages (or promotes them, if they were used), the hot hand demotes hot pages that weren't used
+//  (and ends the test periods it passes), and the test hand ends test periods when there are more test pages than frames.
+//  This is the commonly used form where every resident cold page is in its test period. Each hand runs in its own loop.
+class ClockPro : public onlineAlgorithm<ClockPro>
+{
+ private:
+	enum pageType : unsigned char {hot, cold, test};
+	static const unsigned int none = 0xFFFFFFFFu;
+	struct entry
+	{
+	 int page;
+	 unsigned int frame; // "none" for a non-resident test page.
+	 unsigned int prev;
+	 unsigned int next;
+	 pageType type;
+	};
+	// The state of one calculation. It's reset at the start of every "calculateAlgorithm" (or stream).
+	std::vector<entry> clock;
+	std::vector<unsigned int> freeentries;
+	std::vector<unsigned int> freeframes;
+	referenceBits referenced; // indexed by entry, not by frame.
+	pageMap<unsigned int> pageentry; // page -> entry, for resident and test pages alike.
+	unsigned int handhot, handcold, handtest;
+	unsigned int counthot, countcold, counttest;
+	unsigned int memmax; // the number of frames.
+	unsigned int coldtarget; // how many frames cold pages are allowed, adapted as test pages are used (or not).
+	unsigned int coldminimum; // never less than 1% of the frames, or with (nearly) every page hot the cold hand would go all the way around for each page fault.
+	int position; // the reference being calculated, and
+	int currentpage; // the page being loaded, so evictions can be reported.
+
+	void link(unsigned int e) // puts a new entry just behind the hot hand, which is the last place any hand will get to.
+	{
+		if (handhot == none)
+		{
+		 clock[e].prev = clock[e].next = e;
+		 handhot = handcold = handtest = e;
+		 return;
+		}
+	 clock[e].next = handhot;
+	 clock[e].prev = clock[handhot].prev;
+	 clock[clock[e].prev].next = e;
+	 clock[handhot].prev = e;
+	}
+
+	void unlink(unsigned int e) // any hand that's on this entry moves on to the next one.
+	{
+	 unsigned int next = (clock[e].next == e ? none : clock[e].next);
+		if (handhot == e) {handhot = next;}
+		if (handcold == e) {handcold = next;}
+		if (handtest == e) {handtest = next;}
+	 clock[clock[e].prev].next = clock[e].next;
+	 clock[clock[e].next].prev = clock[e].prev;
+	 pageentry.erase(clock[e].page);
+	 freeentries.push_back(e);
+	}
+
+	void addEntry(int page, pageType type) // loads "page" into a frame, replacing a cold page first if every frame is in use.
+	{
+		while (freeframes.empty())
+		{runHandCold();}
+	 unsigned int e = freeentries.back();
+	 freeentries.pop_back();
+	 unsigned int c = freeframes.back();
+	 freeframes.pop_back();
+	 clock[e] = entry{page, c, none, none, type};
+	 referenced.clear(e);
+	 pageentry[page] = e;
+	 setCurrentCacheLine()[c] = page;
+	 (type == hot ? counthot : countcold)++;
+	 link(e);
+	 balance();
+	}
+
+	void balance() // keeps hot pages within their share of the frames, and the number of test pages within the number of frames.
+	{
+		while (counthot > memmax - coldtarget)
+		{runHandHot();}
+		while (counttest > memmax)
+		{runHandTest();}
+	}
+
+	void endTest(unsigned int e) // a test period ended without the page being used again, so cold pages are given less room.
+	{
+	 unlink(e);
+	 counttest--;
+		if (coldtarget > coldminimum)
+		{coldtarget--;}
+	}
+
+	void runHandCold()
+	{
+	 unsigned int e = handcold;
+	 handcold = clock[e].next;
+		if (clock[e].type == cold)
+		{
+			if (referenced.test(e)) // used during its test period, so it becomes hot.
+			{
+			 referenced.clear(e);
+			 clock[e].type = hot;
+			 countcold--;
+			 counthot++;
+			}
+			else // replaced, but remembered as a test page.
+			{
+			 pageEvict(position, clock[e].frame, clock[e].page, currentpage);
+			 freeframes.push_back(clock[e].frame);
+			 clock[e].frame = none;
+			 clock[e].type = test;
+			 countcold--;
+			 counttest++;
+			}
+		 balance();
+		}
+	}
+
+	void runHandHot() // demotes hot pages that weren't used since it last passed, and ends the test period of any test page it passes.
+	{
+	 unsigned int e = handhot;
+	 handhot = clock[e].next;
+		if (clock[e].type == hot)
+		{
+			if (referenced.test(e))
+			{referenced.clear(e);}
+			else
+			{
+			 clock[e].type = cold;
+			 counthot--;
+			 countcold++;
+			}
+		}
+		else if (clock[e].type == test)
+		{endTest(e);}
+	}
+
+	void runHandTest()
+	{
+	 unsigned int e = handtest;
+	 handtest = clock[e].next;
+		if (clock[e].type == test)
+		{endTest(e);}
+	}
+
+ public:
+ ClockPro(){} // Default Constructor
+ ClockPro(std::string pname) : onlineAlgorithm<ClockPro>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<ClockPro>(*this);}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 memmax = getFrameFinalSize();
+	 coldtarget = memmax;
+	 coldminimum = std::max(1u, memmax / 100);
+	 counthot = countcold = counttest = 0;
+	 position = currentpage = 0;
+	 handhot = handcold = handtest = none;
+	 clock.assign(2 * memmax + 1, entry{0, none, none, none, test});
+	 freeentries.clear();
+		for (unsigned int e = (unsigned int)clock.size(); e > 0; e--)
+		{freeentries.push_back(e - 1);}
+	 freeframes.clear();
+		for (unsigned int c = memmax; c > 0; c--)
+		{freeframes.push_back(c - 1);}
+	 referenced.reset((unsigned int)clock.size());
+	 restartArena(getArena(), pageentry);
+	 pageentry.reserve(clock.size());
+	}
+
+	void firstReference(int, int page) // the first cache line is loaded cold, in order, and any page used again before it's full is marked.
+	{
+	 pageMap<unsigned int>::iterator itr_entry = pageentry.find(page);
+		if (itr_entry == pageentry.end())
+		{addEntry(page, cold);}
+		else
+		{referenced.set(itr_entry->second);}
+	}
+
+	void firstLineDone(){}
+
+	bool nextReference(int i, int page)
+	{
+	 pageMap<unsigned int>::iterator itr_entry = pageentry.find(page);
+		if (itr_entry != pageentry.end() && clock[itr_entry->second].type != test)
+		{
+		 pageHit(i, page);
+		 referenced.set(itr_entry->second);
+		 return true;
+		}
+	 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+	 position = i;
+	 currentpage = page;
+		if (itr_entry != pageentry.end()) // a test page was used again, so cold pages get more room and it comes back hot.
+		{
+			if (coldtarget < memmax)
+			{coldtarget++;}
+		 unlink(itr_entry->second);
+		 counttest--;
+		 addEntry(page, hot);
+		}
+		else
+		{addEntry(page, cold);}
+	 addCacheLine(); // add finished frames to the cache.
+	 return false;
+	}
+
+};
+
+// ARC, the Adaptive Replacement Cache (Megiddo and Modha, 2003).
+// Resident pages seen once recently are kept in T1, and pages seen at least twice in T2. Pages replaced from either are remembered
+// (without a frame) in the "ghost" lists B1 and B2. A page fault on a ghost shows which side would have kept it, so the target size
+// of T1, 'p', is moved towards that side. A long scan only ever passes through T1, so the pages in T2 survive it.
+// All four lists share one pool of 2 * frames entries, so memory for the ghosts is bounded, and every step is O(1).
+class Arc : public onlineAlgorithm<Arc>
+{
+ private:
+	static const unsigned int none = 0xFFFFFFFFu;
+	enum listType : unsigned char {t1, t2, b1, b2};
+	struct entry
+	{
+	 int page;
+	 unsigned int frame; // "none" for a ghost.
+	 listType list;
+	};
+	// The state of one calculation. It's reset at the start of every "calculateAlgorithm" (or stream).
+	std::vector<entry> entries;
+	recencyList lists[4]; // indexed by "listType". The front of each list is its least recently used entry.
+	std::vector<unsigned int> freeentries;
+	std::vector<unsigned int> freeframes;
+	pageMap<unsigned int> pageentry;
+	unsigned int frames;
+	unsigned int p; // target size of T1.
+	unsigned long long ghosthits[2]; // page faults on pages in B1 and B2.
+	std::vector<unsigned int> ptrace; // 'p' after each cache line, only kept while snapshots are being captured.
+	int position;
+
+	void move(unsigned int e, listType list) // moves an entry to the most recently used end of "list".
+	{
+	 lists[entries[e].list].remove(e);
+	 entries[e].list = list;
+	 lists[list].pushBack(e);
+	}
+
+	void forget(listType list) // drops the least recently used ghost of B1 or B2 altogether.
+	{
+	 unsigned int e = lists[list].front();
+	 lists[list].remove(e);
+	 pageentry.erase(entries[e].page);
+	 freeentries.push_back(e);
+	}
+
+	void replace(bool inb2, int page) // frees a frame by turning the least recently used page of T1 or T2 into a ghost.
+	{
+	 listType from = ((lists[t1].size() >= 1 && ((inb2 && lists[t1].size() == p) || lists[t1].size() > p)) ? t1 : t2);
+	 unsigned int e = lists[from].front();
+	 pageEvict(position, entries[e].frame, entries[e].page, page);
+	 freeframes.push_back(entries[e].frame);
+	 entries[e].frame = none;
+	 move(e, (from == t1 ? b1 : b2));
+	}
+
+	unsigned int load(unsigned int e, int page) // gives an entry the next free frame.
+	{
+	 unsigned int c = freeframes.back();
+	 freeframes.pop_back();
+	 entries[e].frame = c;
+	 setCurrentCacheLine()[c] = page;
+	 return c;
+	}
+
+ public:
+ Arc(){} // Default Constructor
+ Arc(std::string pname) : onlineAlgorithm<Arc>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<Arc>(*this);}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 frames = getFrameFinalSize();
+	 p = 0;
+	 ghosthits[0] = ghosthits[1] = 0;
+	 ptrace.clear();
+	 position = 0;
+	 entries.assign(2 * frames, entry{0, none, t1});
+		for (recencyList &list : lists)
+		{list.reset(2 * frames);}
+	 freeentries.clear();
+		for (unsigned int e = 2 * frames; e > 0; e--)
+		{freeentries.push_back(e - 1);}
+	 freeframes.clear();
+		for (unsigned int c = frames; c > 0; c--)
+		{freeframes.push_back(c - 1);}
+	 restartArena(getArena(), pageentry);
+	 pageentry.reserve(2 * frames);
+	}
+
+	void firstReference(int, int page) // the first cache line: new pages go to T1, and pages used again before it's full move to T2.
+	{
+	 pageMap<unsigned int>::iterator itr_entry = pageentry.find(page);
+		if (itr_entry != pageentry.end())
+		{move(itr_entry->second, t2);}
+		else
+		{
+		 unsigned int e = freeentries.back();
+		 freeentries.pop_back();
+		 entries[e] = entry{page, none, t1};
+		 lists[t1].pushBack(e);
+		 pageentry.emplace(page, e);
+		 load(e, page);
+		}
+	}
+
+	void firstLineDone()
+	{
+		if (getSnapshotCapture())
+		{ptrace.push_back(p);}
+	}
+
+	bool nextReference(int i, int page)
+	{
+	 position = i;
+	 pageMap<unsigned int>::iterator itr_entry = pageentry.find(page);
+	 unsigned int e;
+		if (itr_entry != pageentry.end() && entries[itr_entry->second].frame != none) // Case I: a hit in T1 or T2.
+		{
+		 pageHit(i, page);
+		 move(itr_entry->second, t2);
+		 return true;
+		}
+	 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+		if (itr_entry != pageentry.end()) // Cases II and III: a ghost hit, so adapt 'p' towards the list it was found in.
+		{
+		 e = itr_entry->second;
+		 bool inb2 = (entries[e].list == b2);
+		 unsigned int b1size = lists[b1].size(), b2size = lists[b2].size();
+			if (!inb2)
+			{p = std::min(frames, p + std::max(1u, b2size / b1size));}
+			else
+			{
+			 unsigned int delta = std::max(1u, b1size / b2size);
+			 p = (p > delta ? p - delta : 0);
+			}
+		 ghosthits[inb2 ? 1 : 0]++;
+		 replace(inb2, page);
+		 move(e, t2);
+		}
+		else // Case IV: a page that isn't remembered at all.
+		{
+		 unsigned int l1 = lists[t1].size() + lists[b1].size();
+		 unsigned int total = l1 + lists[t2].size() + lists[b2].size();
+			if (l1 == frames)
+			{
+				if (lists[t1].size() < frames)
+				{
+				 forget(b1);
+				 replace(false, page);
+				}
+				else // B1 is empty, so the least recently used page of T1 is dropped without becoming a ghost.
+				{
+				 unsigned int victim = lists[t1].front();
+				 pageEvict(i, entries[victim].frame, entries[victim].page, page);
+				 freeframes.push_back(entries[victim].frame);
+				 forget(t1);
+				}
+			}
+			else if (total >= frames)
+			{
+				if (total == 2 * frames)
+				{forget(b2);}
+			 replace(false, page);
+			}
+		 e = freeentries.back();
+		 freeentries.pop_back();
+		 entries[e] = entry{page, none, t1};
+		 lists[t1].pushBack(e);
+		 pageentry.emplace(page, e);
+		}
+	 load(e, page);
+	 addCacheLine(); // add finished frames to the cache.
+		if (getSnapshotCapture())
+		{ptrace.push_back(p);}
+	 return false;
+	}
+
+	virtual void renderAlgorithm(textBuffer &out) override // The same table as every other algorithm, followed by how often the ghosts were hit and how 'p' moved.
+	{
+	 algorithmType::renderAlgorithm(out);
+	 unsigned long long misses = std::max(1u, getMiss());
+	 out << "\n" << getName() << " ghost hits: B1 " << ghosthits[0] << ", B2 " << ghosthits[1]
+	     << " (" << 100.0 * (ghosthits[0] + ghosthits[1]) / misses << "% of page faults)";
+		if (!ptrace.empty())
+		{
+		 out << "\n" << getName() << " target T1 size (p):";
+			for (const unsigned int &value : ptrace)
+			{out << " " << value;}
+		}
+		else
+		{out << "\n" << getName() << " final target T1 size (p): " << p;}
+	}
+
+};
+
+// 2Q (Johnson and Shasha, 1994), the "full" version. A page seen for the first time goes into A1in, a FIFO holding about a quarter of the
+// frames. When it leaves A1in its page number is remembered in A1out, a ghost FIFO as long as half the frames, and only a page that's
+// used again while it's in A1out is loaded into Am, the main LRU list. So pages that are only used once (like a scan) never reach Am.
+class TwoQ : public onlineAlgorithm<TwoQ>
+{
+ private:
+	static const unsigned int none = 0xFFFFFFFFu;
+	enum listType : unsigned char {a1in, a1out, am};
+	struct entry
+	{
+	 int page;
+	 unsigned int frame; // "none" for a ghost in A1out.
+	 listType list;
+	};
+	std::vector<entry> entries;
+	recencyList lists[3]; // indexed by "listType". A1in and A1out are only ever used as FIFOs.
+	std::vector<unsigned int> freeentries;
+	std::vector<unsigned int> freeframes;
+	pageMap<unsigned int> pageentry;
+	unsigned int kin; // the most frames A1in may hold before it has to give one up.
+	unsigned int kout; // the most ghosts A1out remembers.
+	unsigned long long ghosthits;
+	std::vector<unsigned int> a1intrace; // the size of A1in after each cache line, only kept while snapshots are being captured.
+
+	void reclaim(int position, int page) // frees a frame, from A1in if it's over its share, otherwise from the end of Am.
+	{
+		if (!freeframes.empty())
+		{return;}
+	 listType from = (lists[a1in].size() > kin || lists[am].empty() ? a1in : am);
+	 unsigned int e = lists[from].front();
+	 pageEvict(position, entries[e].frame, entries[e].page, page);
+	 freeframes.push_back(entries[e].frame);
+	 entries[e].frame = none;
+	 lists[from].remove(e);
+		if (from == a1in) // remembered in A1out, which forgets its oldest ghost once it's full.
+		{
+		 entries[e].list = a1out;
+		 lists[a1out].pushBack(e);
+			if (lists[a1out].size() > kout)
+			{
+			 unsigned int oldest = lists[a1out].front();
+			 lists[a1out].remove(oldest);
+			 pageentry.erase(entries[oldest].page);
+			 freeentries.push_back(oldest);
+			}
+		}
+		else
+		{
+		 pageentry.erase(entries[e].page);
+		 freeentries.push_back(e);
+		}
+	}
+
+	void load(int page, listType list, unsigned int e)
+	{
+	 unsigned int c = freeframes.back();
+	 freeframes.pop_back();
+	 entries[e] = entry{page, c, list};
+	 lists[list].pushBack(e);
+	 pageentry[page] = e;
+	 setCurrentCacheLine()[c] = page;
+	}
+
+ public:
+ TwoQ(){} // Default Constructor
+ TwoQ(std::string pname) : onlineAlgorithm<TwoQ>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<TwoQ>(*this);}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 unsigned int frames = getFrameFinalSize();
+	 kin = std::max(1u, frames / 4); // the sizes recommended in the paper.
+	 kout = std::max(1u, frames / 2);
+	 ghosthits = 0;
+	 a1intrace.clear();
+	 unsigned int capacity = frames + kout + 1;
+	 entries.assign(capacity, entry{0, none, a1in});
+		for (recencyList &list : lists)
+		{list.reset(capacity);}
+	 freeentries.clear();
+		for (unsigned int e = capacity; e > 0; e--)
+		{freeentries.push_back(e - 1);}
+	 freeframes.clear();
+		for (unsigned int c = frames; c > 0; c--)
+		{freeframes.push_back(c - 1);}
+	 restartArena(getArena(), pageentry);
+	 pageentry.reserve(capacity);
+	}
+
+	void firstReference(int, int page) // the first cache line: every page starts in A1in, where being used again changes nothing.
+	{
+		if (pageentry.find(page) == pageentry.end())
+		{
+		 unsigned int e = freeentries.back();
+		 freeentries.pop_back();
+		 load(page, a1in, e);
+		}
+	}
+
+	void firstLineDone()
+	{
+		if (getSnapshotCapture())
+		{a1intrace.push_back(lists[a1in].size());}
+	}
+
+	bool nextReference(int i, int page)
+	{
+	 pageMap<unsigned int>::iterator itr_entry = pageentry.find(page);
+		if (itr_entry != pageentry.end() && entries[itr_entry->second].frame != none)
+		{
+		 pageHit(i, page);
+			if (entries[itr_entry->second].list == am)
+			{lists[am].moveToBack(itr_entry->second);}
+		 return true;
+		}
+	 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+		if (itr_entry != pageentry.end()) // a ghost in A1out, so the page has earned its place in Am.
+		{
+		 unsigned int e = itr_entry->second;
+		 ghosthits++;
+		 lists[a1out].remove(e);
+		 pageentry.erase(itr_entry);
+		 freeentries.push_back(e);
+		 reclaim(i, page);
+		 e = freeentries.back();
+		 freeentries.pop_back();
+		 load(page, am, e);
+		}
+		else
+		{
+		 reclaim(i, page);
+		 unsigned int e = freeentries.back();
+		 freeentries.pop_back();
+		 load(page, a1in, e);
+		}
+	 addCacheLine(); // add finished frames to the cache.
+		if (getSnapshotCapture())
+		{a1intrace.push_back(lists[a1in].size());}
+	 return false;
+	}
+
+	virtual void renderAlgorithm(textBuffer &out) override // The same table as every other algorithm, followed by how often A1out was hit and how full A1in was.
+	{
+	 algorithmType::renderAlgorithm(out);
+	 unsigned long long misses = std::max(1u, getMiss());
+	 out << "\n" << getName() << " ghost hits: A1out " << ghosthits << " (" << 100.0 * ghosthits / misses << "% of page faults)";
+		if (!a1intrace.empty())
+		{
+		 out << "\n" << getName() << " A1in size:";
+			for (const unsigned int &value : a1intrace)
+			{out << " " << value;}
+		}
+	}
+
+};
+
+// This function hashes a page ID (see "hashAddress"). Negative IDs are hashed bit for bit, like every other ID.
+std::uint64_t hashPage(int page)
+{return hashAddress((std::uint64_t)(std::uint32_t)page);}
+
+// This is a HELPER class (not an algorithm) that estimates how often each page was used recently: a Count-Min sketch of 4 bit counters.
+// Each page is hashed to one 64 byte block (8 words of 16 counters) and uses one counter in each of 4 of its words, so an update or
+// an estimate touches a single cache line. The estimate is the smallest of the 4 counters.
+// In front of it is a "doorkeeper" Bloom filter: a page's first use only sets its doorkeeper bits, so pages used once never
+// take up counters. Once "samplesize" uses have been counted, every counter is halved and the doorkeeper is cleared (aging),
+// so old popularity fades.
+class frequencySketch
+{
+ public:
+	void reset(unsigned int capacity) // sized for a cache of "capacity" pages.
+	{
+	 std::size_t words = 8;
+		while (words < capacity)
+		{words <<= 1;}
+	 table.assign(words + 7, 0); // a vector is only aligned to its element, so 7 spare words leave room to start at a 64 byte boundary.
+	 first = (std::size_t)((64 - (std::uintptr_t)table.data() % 64) % 64) / sizeof(std::uint64_t);
+	 blockmask = words / 8 - 1;
+	 doorkeeper.assign(words, 0); // 64 bits per word, so about 64 bits per page.
+	 doorkeepermask = words * 64 - 1;
+	 samplesize = 10 * (std::uint64_t)std::max(1u, capacity);
+	 additions = 0;
+	}
+
+	void increment(int page)
+	{
+	 std::uint64_t hash = hashPage(page);
+		if (!setDoorkeeper(hash)) // the first time it's been seen since the last aging.
+		{return;}
+	 std::uint64_t *block = &table[first + ((hash >> 32) & blockmask) * 8];
+		for (unsigned int i = 0; i < 4; i++)
+		{
+		 std::uint64_t &word = block[i * 2 + ((hash >> i) & 1)];
+		 unsigned int shift = (unsigned int)((hash >> (8 + i * 4)) & 15) * 4;
+			if (((word >> shift) & 15) < 15)
+			{word += (1ull << shift);}
+		}
+		if (++additions >= samplesize)
+		{age();}
+	}
+
+	unsigned int frequency(int page) const
+	{
+	 std::uint64_t hash = hashPage(page);
+	 const std::uint64_t *block = &table[first + ((hash >> 32) & blockmask) * 8];
+	 unsigned int estimate = 15;
+		for (unsigned int i = 0; i < 4; i++)
+		{
+		 std::uint64_t word = block[i * 2 + ((hash >> i) & 1)];
+		 unsigned int shift = (unsigned int)((hash >> (8 + i * 4)) & 15) * 4;
+		 estimate = std::min(estimate, (unsigned int)((word >> shift) & 15));
+		}
+	 return estimate + (inDoorkeeper(hash) ? 1 : 0);
+	}
+
+ private:
+	bool inDoorkeeper(std::uint64_t hash) const
+	{
+	 std::uint64_t a = hash & doorkeepermask, b = (hash >> 24) & doorkeepermask;
+	 return ((doorkeeper[a / 64] >> (a % 64)) & 1) && ((doorkeeper[b / 64] >> (b % 64)) & 1);
+	}
+
+	bool setDoorkeeper(std::uint64_t hash) // returns true if the page was already in the doorkeeper.
+	{
+		if (inDoorkeeper(hash))
+		{return true;}
+	 std::uint64_t a = hash & doorkeepermask, b = (hash >> 24) & doorkeepermask;
+	 doorkeeper[a / 64] |= (1ull << (a % 64));
+	 doorkeeper[b / 64] |= (1ull << (b % 64));
+		if (++additions >= samplesize)
+		{age();}
+	 return false;
+	}
+
+	void age()
+	{
+		for (std::uint64_t &word : table)
+		{word = (word >> 1) & 0x7777777777777777ull;}
+	 std::fill(doorkeeper.begin(), doorkeeper.end(), 0);
+	 additions /= 2;
+	}
+
+	std::vector<std::uint64_t> table;
+	std::size_t first; // the word of "table" where the blocks start: an index rather than a pointer, so a copy of the sketch still works.
+	std::vector<std::uint64_t> doorkeeper;
+	std::uint64_t blockmask;
+	std::uint64_t doorkeepermask;
+	std::uint64_t samplesize;
+	std::uint64_t additions;
+};
+
+// W-TinyLFU (Einziger, Friedman and Manes, 2017). New pages go into a small LRU "window" (1% of the frames). The rest of the frames are
+// the main cache, a segmented LRU: pages enter its "probation" segment, and move to the "protected" segment (80% of the main cache)
+// when they're used again. When the window overflows, its oldest page only gets into the main cache if the frequency sketch says
+// it's been used more often than the page the main cache would have to give up for it. Otherwise it's the one that's replaced.
+class WTinyLfu : public onlineAlgorithm<WTinyLfu>
+{
+ private:
+	enum listType : unsigned char {window, probation, protectedlist};
+	// The state of one calculation. It's reset at the start of every "calculateAlgorithm" (or stream).
+	recencyList lists[3]; // indexed by "listType", all over frame indexes. The front of each list is its least recently used frame.
+	std::vector<listType> framelist; // which list each frame is in.
+	pageMap<unsigned int> pageframe; // page -> index of the frame that currently holds it.
+	frequencySketch sketch;
+	unsigned int frames, windowsize, mainsize, protectedsize;
+	unsigned long long accepted, rejected; // admissions from the window into the main cache.
+
+	void put(unsigned int c, listType list)
+	{
+	 framelist[c] = list;
+	 lists[list].pushBack(c);
+	}
+
+	void take(unsigned int c)
+	{lists[framelist[c]].remove(c);}
+
+ public:
+ WTinyLfu(){} // Default Constructor
+ WTinyLfu(std::string pname) : onlineAlgorithm<WTinyLfu>(pname){} // Overloaded Constructor. Used if object was assigned a name when it was initialized.
+
+	virtual std::shared_ptr<algorithmType> clone() const override
+	{return std::make_shared<WTinyLfu>(*this);}
+
+	// These are called by "onlineAlgorithm" (both for "calculateAlgorithm" and "access").
+	void resetState()
+	{
+	 frames = getFrameFinalSize();
+	 windowsize = std::max(1u, frames / 100);
+	 mainsize = frames - windowsize;
+	 protectedsize = mainsize * 4 / 5;
+	 accepted = rejected = 0;
+	 sketch.reset(frames);
+		for (recencyList &list : lists)
+		{list.reset(frames);}
+	 framelist.assign(frames, window);
+	 restartArena(getArena(), pageframe);
+	 pageframe.reserve(frames);
+	}
+
+	void firstReference(int, int page) // the first cache line: the newest pages fill the window, and everything older is on probation.
+	{
+	 sketch.increment(page);
+	 unsigned int c = (unsigned int)pageframe.size();
+		if (pageframe.emplace(page, c).second)
+		{put(c, (c + windowsize >= frames ? window : probation));}
+	}
+
+	void firstLineDone(){}
+
+	bool nextReference(int i, int page)
+	{
+	 sketch.increment(page);
+	 pageMap<unsigned int>::iterator itr_frame = pageframe.find(page);
+		if (itr_frame != pageframe.end())
+		{
+		 pageHit(i, page);
+		 unsigned int c = itr_frame->second;
+			if (framelist[c] == probation) // used again, so it's promoted, and the protected segment may have to demote its oldest page.
+			{
+			 take(c);
+			 put(c, protectedlist);
+				if (lists[protectedlist].size() > protectedsize)
+				{
+				 unsigned int oldest = lists[protectedlist].front();
+				 take(oldest);
+				 put(oldest, probation);
+				}
+			}
+			else
+			{lists[framelist[c]].moveToBack(c);}
+		 return true;
+		}
+	 pageMiss(i, page); // page miss, then decide what to do next depending on the algorithm.
+	 // Every frame is in use, so the window's oldest page (the candidate) either replaces the main cache's next victim, or is replaced itself.
+	 unsigned int candidate = lists[window].front();
+	 unsigned int c = candidate;
+		if (mainsize > 0)
+		{
+		 unsigned int victim = (!lists[probation].empty() ? lists[probation].front() : lists[protectedlist].front());
+			if (sketch.frequency(setCurrentCacheLine()[candidate]) > sketch.frequency(setCurrentCacheLine()[victim]))
+			{
+			 accepted++;
+			 take(candidate);
+			 put(candidate, probation);
+			 c = victim;
+			}
+			else
+			{rejected++;}
+		}
+	 pageEvict(i, c, setCurrentCacheLine()[c], page);
+	 take(c);
+	 pageframe.erase(setCurrentCacheLine()[c]);
+	 pageframe.emplace(page, c);
+	 setCurrentCacheLine()[c] = page;
+	 put(c, window);
+	 addCacheLine(); // add finished frames to the cache.
+	 return false;
+	}
+
+	virtual void renderAlgorithm(textBuffer &out) override // The same table as every other algorithm, followed by how many pages were let into the main cache.
+	{
+	 algorithmType::renderAlgorithm(out);
+	 out << "\n" << getName() << " admissions: " << accepted << " accepted, " << rejected << " rejected";
+	}
+
+};
+
+// Functions.
+//================================================================================================================
+
+// This function removes all whitespace completely.
+//================================================================================================================
+void remove_all_whitespaces(std::string &str)
+{str.erase(remove_if(str.begin(), str.end(), [](char ch){return std::isspace<char>(ch, std::locale::classic());} ), str.end());}
+
+// These functions trim the white spaces from either side of the input.
+//================================================================================================================
+// trim from start
+std::string &ltrim(std::string &s)
+{
+ //s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](char c) {return (bool)!(std::isspace(c));}));
+ s.erase(s.begin(), std::find_if(s.begin(), s.end(), [](char ch){return (bool)!(std::isspace<char>(ch, std::locale::classic()));} ));
+ return s;
+}
+
+// trim from end
+std::string &rtrim(std::string &s)
+{
+ //s.erase(std::find_if(s.rbegin(), s.rend(), [](char c) {return (bool)!(std::isspace(c));}).base(), s.end());
+ s.erase(std::find_if(s.rbegin(), s.rend(), [](char ch){return (bool)!(std::isspace<char>(ch, std::locale::classic()));} ).base(), s.end());
+ return s;
+}
+
+// trim from both ends
+std::string &trim(std::string &s)
+{return ltrim(rtrim(s));}
+
+// This function merges all multiple white spaces in a row, into one 'space', even if no 'space' character is found.
+// For practical usability, this function allows ANY white spaces in a row ('space', tab, newline, etc.) to be used as a delimiter.
+//================================================================================================================
+void remove_extra_whitespaces(std::string &input) //, std::string &output)
+{
+ std::string output; // = "NO_OUTPUT_YET";
+ output.clear();  // unless you want to add at the end of existing string, clear the output so it's ready to accept new input.
+ //unique_copy (input.begin(), input.end(), std::back_insert_iterator<std::string>(output), [](char a,char b){ return std::isspace(a) && std::isspace(b);});
+ unique_copy (input.begin(), input.end(), std::back_insert_iterator<std::string>(output), [](char a, char b){return std::isspace<char>(a, std::locale::classic()) && std::isspace<char>(b, std::locale::classic());} );
+ replace_if(output.begin(), output.end(), [](char ch){return std::isspace<char>(ch, std::locale::classic());} , ' '); // makes all characters that are any type of whitespace into single 'space'.
+ input = output;
+}
+
+// This function acts as "cin>>", but without the headache of having to worry about maintaining the input buffer.
+// The use of "cin >>" requires "std::cin.clear()" and "std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n')"
+// immediately after you use it. This method is cleaner, safer and more portable.
+//================================================================================================================
+void cin_custom(std::string &str)
+{
+ getline(std::cin, str); // Causes a newline to be created here as well.
+ ltrim(str);
+	for(unsigned int i = 0; i < str.length(); i++)
+	{
+		if (std::isspace(str[i]))
 		{
 		 str.erase(str.begin() + i, str.end());
 		 break;
@@ -450,219 +2880,3196 @@ void cin_custom(std::string &str)
 	}
 }
 
-// This function takes care of setting up all objects for the next calculation by resetting certain values.
-//================================================================================================================
-void cleanUp (std::vector<std::shared_ptr<algorithmType>> &algvector)
+// This function takes care of setting up all objects for the next calculation by resetting certain values.
+//================================================================================================================
+void cleanUp (std::vector<std::shared_ptr<algorithmType>> &algvector)
+{
+	// Range based "for" loop that loops through each object of type "algorithmType" and resets everything for each new loop in "main".
+	for (std::shared_ptr<algorithmType> &alg : algvector)
+	{
+	 alg->clearAlg();
+	 alg->setRow(0);
+	 alg->setMiss(0);
+	 alg->setHit(0);
+	}
+}
+
+// Function that uses a range based "for" loop to calculate every algorithm that was added to the vector "algvector".
+//================================================================================================================
+void calculateAllAlgorithms (std::vector<std::shared_ptr<algorithmType>> &algvector, const int &refstrcount, const traceView &refstr)
+{
+	for (std::shared_ptr<algorithmType> &alg : algvector)
+	{alg->measureAlgorithm(refstrcount, refstr);}
+}
+
+// Function that sets the number of frames of every algorithm that was added to the vector "algvector".
+//================================================================================================================
+void setAllFrameSizes (std::vector<std::shared_ptr<algorithmType>> &algvector, const int &framecount)
+{
+	for (std::shared_ptr<algorithmType> &alg : algvector)
+	{alg->setFrameFinalSize(framecount);}
+}
+
+// This function runs "job(0)" to "job(count - 1)" on "threadcount" threads (0 = one per hardware thread), the calling thread included.
+// Each thread takes the next job that hasn't been started, until there are none left. Any job that fails (e.g. out of memory)
+// fails the whole call, but only once every thread is done.
+//================================================================================================================
+void parallelFor (std::size_t count, unsigned int threadcount, const std::function<void(std::size_t)> &job)
+{
+	if (threadcount == 0)
+	{threadcount = std::max(1u, std::thread::hardware_concurrency());}
+ threadcount = (unsigned int)std::min<std::size_t>(threadcount, count);
+ std::atomic<std::size_t> nextjob(0);
+ std::vector<std::exception_ptr> errors(count);
+ auto worker = [&]()
+ {
+	for (std::size_t j = nextjob++; j < count; j = nextjob++)
+	{
+		try
+		{job(j);}
+		catch(...)
+		{errors[j] = std::current_exception();}
+	}
+ };
+ std::vector<std::thread> pool;
+	for (unsigned int t = 1; t < threadcount; t++)
+	{pool.emplace_back(worker);}
+ worker(); // the calling thread works too, instead of just waiting.
+	for (std::thread &thread : pool)
+	{thread.join();}
+	for (std::exception_ptr &error : errors)
+	{
+		if (error)
+		{std::rethrow_exception(error);}
+	}
+}
+
+// This function returns "framesizes" with every number of frames over "refstrcount" cut down to it (a trace can't fill more frames
+// than it has references), sorted, and with each number only once, so two sizes that both became "refstrcount" aren't run twice.
+//================================================================================================================
+std::vector<int> clampFrameList(const std::vector<int> &framesizes, int refstrcount)
+{
+ std::vector<int> clamped;
+	for (const int &framecount : framesizes)
+	{clamped.push_back(std::min(framecount, refstrcount));}
+ std::sort(clamped.begin(), clamped.end());
+ clamped.erase(std::unique(clamped.begin(), clamped.end()), clamped.end());
+ return clamped;
+}
+
+// Function that calculates every algorithm in "algvector", once for each number of frames in "framesizes", all at the same time.
+// Each (algorithm, frames) job runs on a clone of the algorithm, so the only thing the threads share is the read only reference string.
+// Clones don't keep the original's observer, since an observer isn't expected to be called from several threads at once.
+// With "observe", each clone gets the observer it makes for that clone instead, one call per clone, in the same order as the clones.
+// Returns the finished clones, ordered by frame size (see "clampFrameList") and then in the same order as "algvector".
+//================================================================================================================
+std::vector<std::shared_ptr<algorithmType>> calculateAllAlgorithmsParallel (const std::vector<std::shared_ptr<algorithmType>> &algvector, const std::vector<int> &framesizes,
+                                                                            const int &refstrcount, const traceView &refstr, unsigned int threadcount,
+                                                                            std::vector<double> *seconds = nullptr, // when given, how long each job took.
+                                                                            const std::function<std::shared_ptr<algorithmObserver>(algorithmType &)> &observe = nullptr)
+{
+ std::vector<std::shared_ptr<algorithmType>> jobs;
+	for (const int &framecount : clampFrameList(framesizes, refstrcount))
+	{
+		for (const std::shared_ptr<algorithmType> &alg : algvector)
+		{
+		 std::shared_ptr<algorithmType> job = alg->specialize((unsigned int)framecount);
+		 job->setObserver(nullptr);
+		 job->clearAlg();
+		 job->setRow(0);
+		 job->setMiss(0);
+		 job->setHit(0);
+		 job->setFrameFinalSize(framecount);
+		 jobs.push_back(job);
+		}
+	}
+	if (seconds)
+	{seconds->assign(jobs.size(), 0.0);}
+	if (observe)
+	{
+		for (std::shared_ptr<algorithmType> &job : jobs)
+		{job->setObserver(observe(*job));}
+	}
+ parallelFor(jobs.size(), threadcount, [&](std::size_t j)
+ {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	jobs[j]->measureAlgorithm(refstrcount, refstr);
+	if (seconds)
+	{(*seconds)[j] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();}
+ });
+ return jobs;
+}
+
+// Function that renders every algorithm that was added to the vector "algvector" into "out", one after another.
+// With "summary", each algorithm gets one line of its statistics (see "algorithmStats") instead of its table, and a bounded lookahead
+// "Opt" gets a line under them with its window and how far from "Opt" it was.
+// Otherwise each table is rendered into a buffer of its own, and when there are enough pages in them to be worth it,
+// on "threadcount" threads (0 = one per hardware thread). Either way, they come out in the order of "algvector".
+//================================================================================================================
+void renderAllAlgorithms (std::vector<std::shared_ptr<algorithmType>> &algvector, textBuffer &out, bool summary = false, unsigned int threadcount = 0)
+{
+	for (std::shared_ptr<algorithmType> &alg : algvector) // a bounded lookahead "Opt" is compared with the exact one, if both were run with the same frames.
+	{
+	 LookaheadOpt *lookahead = dynamic_cast<LookaheadOpt *>(alg.get());
+		for (std::shared_ptr<algorithmType> &other : algvector)
+		{
+			if (lookahead && dynamic_cast<Opt *>(other.get()) && other->getFrameFinalSize() == lookahead->getFrameFinalSize())
+			{lookahead->setExactFaults(other->getMiss());}
+		}
+	}
+	if (summary)
+	{
+	 std::ostringstream table; // the columns are lined up by the stream.
+	 std::vector<algorithmStats> stats;
+	 bool instrumented = false, hardware = false;
+		for (std::shared_ptr<algorithmType> &alg : algvector)
+		{
+		 stats.push_back(alg->getStats());
+		 instrumented = instrumented || stats.back().instrumented;
+		 hardware = hardware || stats.back().hardware;
+		}
+	 table << std::left << std::setw(24) << "algorithm" << std::right << std::setw(12) << "faults" << std::setw(12) << "hits";
+		if (instrumented)
+		{table << std::setw(12) << "evictions" << std::setw(14) << "lookups" << std::setw(8) << "probes" << std::setw(16) << "snapshot bytes" << std::setw(12) << "ms";}
+		if (hardware)
+		{table << std::setw(16) << "cycles" << std::setw(14) << "cache misses" << std::setw(14) << "branch misses";}
+	 table << "\n";
+		for (std::size_t a = 0; a < algvector.size(); a++)
+		{
+		 const algorithmStats &s = stats[a];
+		 table << std::left << std::setw(24) << algvector[a]->getName() << std::right << std::setw(12) << s.misses << std::setw(12) << s.hits;
+			if (instrumented) // "probes" is the average number of frames each search compared.
+			{
+			 table << std::setw(12) << s.evictions << std::setw(14) << s.lookups << std::setw(8) << std::fixed << std::setprecision(2)
+			           << (s.lookups > 0 ? (double)s.probes / s.lookups : 0.0) << std::setw(16) << s.snapshotbytes << std::setw(12)
+			           << s.seconds * 1000.0 << std::defaultfloat << std::setprecision(6);
+			}
+			if (hardware)
+			{table << std::setw(16) << s.cycles << std::setw(14) << s.cachemisses << std::setw(14) << s.branchmisses;}
+		 table << "\n";
+		}
+	 out << table.str();
+		for (std::shared_ptr<algorithmType> &alg : algvector)
+		{
+		 LookaheadOpt *lookahead = dynamic_cast<LookaheadOpt *>(alg.get());
+			if (lookahead)
+			{
+			 lookahead->renderWindow(out);
+			 out << "\n";
+			}
+		}
+		if (!instrumented)
+		{out << "(build with -DPAGE_REPLACE_STATS for the evictions, frame searches, time and hardware counters)\n";}
+	 return;
+	}
+ const std::size_t parallelpages = 1 << 16; // tables with fewer pages than this in all are rendered on the calling thread alone.
+ std::size_t pages = 0;
+	for (std::shared_ptr<algorithmType> &alg : algvector)
+	{pages += alg->getVector().size() * alg->getVector().width();}
+ std::vector<textBuffer> tables(algvector.size());
+ parallelFor(algvector.size(), (pages < parallelpages ? 1 : threadcount), [&](std::size_t a)
+ {algvector[a]->renderAlgorithm(tables[a]);});
+	for (std::size_t a = 0; a < tables.size(); a++)
+	{
+	 out << tables[a];
+		if (a + 1 < tables.size()) // Do not automatically put a space after the last algorithm output.
+		{
+		 out << "\n\n"; // Space in between each algorithm output.
+		}
+	}
+}
+
+// Function that displays every algorithm that was added to the vector "algvector" (see "renderAllAlgorithms"), all in one write.
+//================================================================================================================
+void displayAllAlgorithms (std::vector<std::shared_ptr<algorithmType>> &algvector, bool summary = false)
+{
+ textBuffer out;
+ renderAllAlgorithms(algvector, out, summary);
+ out.writeTo(stdout);
+}
+
+// This is a HELPER class for the miss ratio curves below. It counts how many references were found at each stack distance.
+// A stack distance of 'd' means the reference is a hit in any cache with at least 'd' frames, and a page fault in anything smaller.
+// Distances bigger than "maxdistance", and the first reference of every page (an infinite distance), are counted together in "beyond".
+//================================================================================================================
+class stackDistanceHistogram
+{
+ public:
+	stackDistanceHistogram() : beyond(0), references(0){}
+
+	void reset(unsigned int maxdistance)
+	{
+	 counts.assign(maxdistance + 1, 0); // counts[0] is never used.
+	 beyond = 0;
+	 references = 0;
+	}
+
+	void add(unsigned long long distance, unsigned long long weight = 1) // a distance of zero means infinite.
+	{
+		if (distance == 0 || distance >= counts.size())
+		{beyond += weight;}
+		else
+		{counts[distance] += weight;}
+	 references += weight;
+	}
+
+	// Returns the number of page faults with 1, 2, ... "maxdistance" frames. Element [0] is for 0 frames (every reference).
+	std::vector<unsigned long long> getFaultCurve() const
+	{
+	 std::vector<unsigned long long> faults(counts.size());
+	 unsigned long long fault = references;
+		for (std::size_t c = 0; c < counts.size(); c++)
+		{
+		 fault -= counts[c];
+		 faults[c] = fault;
+		}
+	 return faults;
+	}
+
+	unsigned int getMaxDistance() const
+	{return (unsigned int)(counts.size() - 1);}
+
+	unsigned long long getReferences() const
+	{return references;}
+
+ private:
+	std::vector<unsigned long long> counts;
+	unsigned long long beyond;
+	unsigned long long references;
+};
+
+// This is a HELPER class. A Fenwick (binary indexed) tree over the positions of the reference string,
+// so the number of marked positions in any range can be counted, and changed, in O(log n).
+//================================================================================================================
+class fenwickTree
+{
+ public:
+	void reset(std::size_t size)
+	{tree.assign(size + 1, 0);}
+
+	void add(std::size_t i, int delta)
+	{
+		for (i++; i < tree.size(); i += (i & (0 - i)))
+		{tree[i] += delta;}
+	}
+
+	long long prefix(std::size_t i) const // sum of positions [0, i).
+	{
+	 long long sum = 0;
+		for (; i > 0; i -= (i & (0 - i)))
+		{sum += tree[i];}
+	 return sum;
+	}
+
+ private:
+	std::vector<int> tree;
+};
+
+// This function finds the LRU stack distance of every reference in one pass (Mattson's stack algorithm).
+// Only the most recent position of each page is marked in the tree, so the distance of a reference is the number of marks
+// since that page's last position, plus one. Each reference takes O(log n), no matter how many frames are being measured.
+// Note: this is exact LRU. The "Lru" class starts its first cache line in the order the pages were added instead of
+// the order they were last used, so with repeats inside the first cache line its count can differ slightly.
+//================================================================================================================
+void lruStackDistances(const int &refstrcount, const traceView &refstr, stackDistanceHistogram &histogram)
+{
+ fenwickTree marks;
+ marks.reset(refstrcount);
+ std::unordered_map<int, int> lastuse; // page -> position it was last referenced at.
+	for (int i = 0; i < refstrcount; i++)
+	{
+	 std::unordered_map<int, int>::iterator itr_pos = lastuse.find(refstr[i]);
+		if (itr_pos == lastuse.end())
+		{
+		 histogram.add(0);
+		 lastuse.emplace(refstr[i], i);
+		}
+		else
+		{
+		 histogram.add((unsigned long long)(marks.prefix(i) - marks.prefix(itr_pos->second)));
+		 marks.add(itr_pos->second, -1);
+		 itr_pos->second = i;
+		}
+	 marks.add(i, 1);
+	}
+}
+
+// This function finds the OPT (Belady) stack distance of every reference in one pass, using Mattson's priority stack.
+// The stack is ordered so that its top 'c' pages are exactly what an optimal cache of 'c' frames holds. On each reference,
+// the page moves to the top and the pages above its old spot are pushed down, each level keeping whichever page is used sooner.
+// Since the priorities (next uses) change with every reference, there is no O(log n) tree for this: each reference costs
+// O(depth), and the stack is cut off at "histogram.getMaxDistance()" frames to keep that bounded.
+//================================================================================================================
+void optStackDistances(const int &refstrcount, const traceView &refstr, stackDistanceHistogram &histogram)
+{
+ std::vector<int> nextuse;
+ std::unordered_map<int, int> firstuse;
+ buildNextUse(refstrcount, refstr, nextuse, firstuse);
+ std::vector<std::pair<int, int>> stack; // (next use, page), top of the stack first.
+ const std::size_t maxdepth = histogram.getMaxDistance();
+ stack.reserve(maxdepth);
+	for (int i = 0; i < refstrcount; i++)
+	{
+	 std::size_t depth = 0;
+		while (depth < stack.size() && stack[depth].second != refstr[i]) {depth++;}
+	 histogram.add((depth < stack.size()) ? depth + 1 : 0);
+	 std::pair<int, int> carry(nextuse[i], refstr[i]);
+		for (std::size_t level = 0; ; level++)
+		{
+			if (level == depth) // the page's old spot (or the bottom of the stack) takes whatever was pushed down this far.
+			{
+				if (level < stack.size())
+				{stack[level] = carry;}
+				else if (stack.size() < maxdepth)
+				{stack.push_back(carry);}
+			 break;
+			}
+			if (level == 0 || carry.first < stack[level].first) // the top always takes the referenced page. Otherwise the sooner used page stays.
+			{std::swap(carry, stack[level]);}
+		}
+	}
+}
+
+// This class estimates the LRU miss ratio curve from a spatially hashed sample of the pages (SHARDS).
+// A page is simulated only if its hash, modulo "modulus", is below the threshold, so every reference to a sampled page is kept and
+// every reference to any other page is skipped. Stack distances found in the sample are scaled up by 1 / rate.
+// With a fixed rate, memory grows with rate * (number of distinct pages). With a budget, the threshold keeps being lowered so
+// no more than "budget" pages are ever tracked, which bounds memory and time no matter how long the trace is.
+// References are given one at a time through "access", so the trace never needs to be in memory.
+//================================================================================================================
+class shardsSampler
+{
+ public:
+	static const std::uint64_t modulus = (1ull << 24);
+
+	// Pass a budget of 0 to sample at a fixed "rate" instead. With a budget, sampling starts at "rate" and only goes down.
+	void reset(double rate, std::size_t pbudget, unsigned int maxdistance)
+	{
+	 threshold = std::max<std::uint64_t>(1, (std::uint64_t)(rate * modulus));
+	 threshold = std::min(threshold, modulus);
+	 budget = pbudget;
+	 counts.assign(maxdistance + 1, 0.0);
+	 beyond = 0.0;
+	 sampled = 0.0;
+	 references = 0;
+	 samplecount = 0;
+	 pages.clear();
+	 byhash.clear();
+	 marks.reset(1024);
+	 capacity = 1024;
+	 now = 0;
+	}
+
+	void access(int page)
+	{
+	 references++;
+	 std::uint64_t hash = hashPage(page) & (modulus - 1);
+		if (hash >= threshold)
+		{return;}
+	 samplecount++;
+	 double rate = getRate();
+	 double weight = 1.0 / rate; // with a budget, the rate drops over time, so later samples stand for more references.
+		if (now == capacity) // before the page's last reference is unmarked, or "compact" would mark it again.
+		{compact();}
+	 std::unordered_map<int, sampledPage>::iterator itr_pos = pages.find(page);
+		if (itr_pos == pages.end())
+		{
+		 add(0, weight);
+		}
+		else
+		{
+		 long long distance = marks.prefix(now) - marks.prefix(itr_pos->second.time);
+		 add((unsigned long long)std::llround(distance / rate), weight);
+		 marks.add(itr_pos->second.time, -1);
+		}
+	 marks.add(now, 1);
+		if (itr_pos == pages.end())
+		{
+		 pages.emplace(page, sampledPage{now, (std::uint32_t)hash});
+			if (budget > 0)
+			{
+			 byhash.insert(std::make_pair((std::uint32_t)hash, page));
+			 shrinkToBudget();
+			}
+		}
+		else
+		{itr_pos->second.time = now;}
+	 now++;
+	}
+
+	// Returns the estimated miss ratio with 1, 2, ... "maxdistance" frames. Element [0] is for 0 frames (always 1).
+	// With a fixed rate, the count at distance 1 is adjusted by however many more (or fewer) references were sampled than expected (SHARDS-adj).
+	std::vector<double> getMissRatioCurve() const
+	{
+	 std::vector<double> curve(counts.size(), 1.0);
+		if (sampled <= 0.0)
+		{return curve;}
+	 double total = sampled;
+	 double first = (counts.size() > 1 ? counts[1] : 0.0);
+		if (budget == 0)
+		{
+		 double adjustment = (double)references - sampled; // expected minus actual, in references.
+		 first += adjustment;
+		 total += adjustment;
+		}
+	 double misses = total;
+		for (std::size_t c = 1; c < counts.size(); c++)
+		{
+		 misses -= (c == 1 ? first : counts[c]);
+		 curve[c] = std::min(1.0, std::max(0.0, misses / total));
+		}
+	 return curve;
+	}
+
+	double getRate() const
+	{return (double)threshold / modulus;}
+
+	std::size_t getTrackedPages() const
+	{return pages.size();}
+
+	unsigned long long getSampledReferences() const
+	{return samplecount;}
+
+ private:
+	struct sampledPage
+	{
+	 std::size_t time; // position in the sampled trace of its last reference (a mark in "marks").
+	 std::uint32_t hash;
+	};
+
+	void add(unsigned long long distance, double weight)
+	{
+		if (distance == 0 || distance >= counts.size())
+		{beyond += weight;}
+		else
+		{counts[distance] += weight;}
+	 sampled += weight;
+	}
+
+	void shrinkToBudget() // lowers the threshold to the biggest hash being tracked, and stops tracking every page with that hash.
+	{
+		while (pages.size() > budget)
+		{
+		 std::uint32_t biggest = byhash.rbegin()->first;
+		 threshold = biggest;
+			while (!byhash.empty() && byhash.rbegin()->first == biggest)
+			{
+			 std::unordered_map<int, sampledPage>::iterator itr_pos = pages.find(byhash.rbegin()->second);
+			 marks.add(itr_pos->second.time, -1);
+			 pages.erase(itr_pos);
+			 byhash.erase(std::prev(byhash.end()));
+			}
+		}
+	}
+
+	void compact() // renumbers the last reference of every tracked page as 0, 1, 2... so the tree only grows with the number of tracked pages.
+	{
+	 std::vector<std::pair<std::size_t, int>> order;
+	 order.reserve(pages.size());
+		for (const std::pair<const int, sampledPage> &entry : pages)
+		{order.push_back(std::make_pair(entry.second.time, entry.first));}
+	 std::sort(order.begin(), order.end());
+	 capacity = std::max<std::size_t>(1024, order.size() * 2 + 1);
+	 marks.reset(capacity);
+		for (std::size_t t = 0; t < order.size(); t++)
+		{
+		 pages[order[t].second].time = t;
+		 marks.add(t, 1);
+		}
+	 now = order.size();
+	}
+
+	std::uint64_t threshold;
+	std::size_t budget;
+	std::vector<double> counts;
+	double beyond;
+	double sampled; // weighted number of sampled references.
+	unsigned long long references; // every reference, sampled or not.
+	unsigned long long samplecount;
+	std::unordered_map<int, sampledPage> pages;
+	std::set<std::pair<std::uint32_t, int>> byhash; // only used with a budget.
+	fenwickTree marks;
+	std::size_t capacity;
+	std::size_t now;
+};
+
+const std::uint64_t shardsSampler :: modulus; // needed by C++11, because "std::min" binds a reference to it.
+
+// This function estimates the OPT miss ratio curve from the same kind of spatially hashed sample, at a fixed rate.
+// OPT needs the future of every sampled page, so the sampled references are gathered first (rate * the length of the trace),
+// then a cache of 'c' frames is estimated by an optimal cache of rate * 'c' frames over the sample.
+// Returns the estimated miss ratio with 0, 1, 2... "maxframes" frames.
+//================================================================================================================
+std::vector<double> shardsOptMissRatioCurve(const int &refstrcount, const traceView &refstr, double rate, unsigned int maxframes)
+{
+ std::uint64_t threshold = std::min(shardsSampler::modulus, std::max<std::uint64_t>(1, (std::uint64_t)(rate * shardsSampler::modulus)));
+ rate = (double)threshold / shardsSampler::modulus;
+ std::vector<int> sample;
+	for (int i = 0; i < refstrcount; i++)
+	{
+		if ((hashPage(refstr[i]) & (shardsSampler::modulus - 1)) < threshold)
+		{sample.push_back(refstr[i]);}
+	}
+ std::vector<double> curve(maxframes + 1, 1.0);
+	if (sample.empty())
+	{return curve;}
+ stackDistanceHistogram histogram;
+ unsigned int maxsampled = (unsigned int)std::ceil(maxframes * rate);
+ histogram.reset(std::max(1u, maxsampled));
+ int samplecount = (int)sample.size();
+ optStackDistances(samplecount, sample, histogram);
+ std::vector<unsigned long long> faults = histogram.getFaultCurve();
+	for (unsigned int c = 1; c <= maxframes; c++)
+	{
+	 std::size_t scaled = (std::size_t)std::llround(c * rate);
+	 curve[c] = (double)faults[std::min(scaled, faults.size() - 1)] / samplecount;
+	}
+ return curve;
+}
+
+// This function is used by function "getInput" to prevent incorrect input from the user from crashing program.
+//================================================================================================================
+int strToInt(const std::string &str, int &i)
+{
+ int r_error = 0;
+	try
+	{
+	 i = (int)std::trunc(stod(str)); // here is where you can change how to handle decimal numbers.
+	                     // I elected to truncate any non integer type variables behind the scenes, without throwing an exception.
+						 // Note, if you use 'stoi' instead, it will implicitly truncate any non integer type variable anyway.
+	}
+     catch(std::invalid_argument&)
+	{
+     // if no conversion could be performed
+	 r_error = 1;
+    }
+    catch(std::out_of_range&)
+	{
+     // if the converted value would fall out of the range of the result type 
+     // or if the underlying function (std::strtol or std::strtoull) sets errno 
+     // to ERANGE.
+	 r_error = 2;
+    }
+    catch(...)
+	{
+     // everything else
+	 r_error = 3;
+    }
+
+ return r_error;
+}
+
+// This is a HELPER class: the xoshiro256** pseudo random number generator. It's fast, has a period of 2^256 - 1, and
+// (unlike "std::rand") gives the same numbers on every platform for the same seed, so every run can be repeated exactly.
+// It meets the requirements of a standard "UniformRandomBitGenerator", so it also works with the <random> distributions.
+//================================================================================================================
+class xoshiro256
+{
+ public:
+	typedef std::uint64_t result_type;
+
+	explicit xoshiro256(std::uint64_t seed = 0)
+	{reseed(seed);}
+
+	void reseed(std::uint64_t seed) // the state is filled from the seed with "splitmix64", as the authors recommend.
+	{
+		for (std::uint64_t &word : state)
+		{
+		 seed += 0x9E3779B97F4A7C15ull;
+		 std::uint64_t z = seed;
+		 z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		 z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		 word = z ^ (z >> 31);
+		}
+	}
+
+	result_type operator()()
+	{
+	 const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+	 const std::uint64_t t = state[1] << 17;
+	 state[2] ^= state[0];
+	 state[3] ^= state[1];
+	 state[1] ^= state[2];
+	 state[0] ^= state[3];
+	 state[2] ^= t;
+	 state[3] = rotl(state[3], 45);
+	 return result;
+	}
+
+	std::uint32_t below(std::uint32_t bound) // a number from 0 to bound - 1, without the bias of '%' (Lemire's multiply and shift).
+	{
+	 std::uint64_t product = ((*this)() >> 32) * bound;
+		if ((std::uint32_t)product < bound) // only then can it be one of the (2^32 % bound) low products that would make some numbers more likely.
+		{
+		 std::uint32_t threshold = (0u - bound) % bound; // 2^32 % bound, in 32 bits.
+			while ((std::uint32_t)product < threshold)
+			{product = ((*this)() >> 32) * bound;}
+		}
+	 return (std::uint32_t)(product >> 32);
+	}
+
+	double uniform() // a number from 0 (inclusive) to 1 (exclusive).
+	{return ((*this)() >> 11) * (1.0 / 9007199254740992.0);}
+
+	static constexpr result_type min()
+	{return 0;}
+
+	static constexpr result_type max()
+	{return UINT64_MAX;}
+
+ private:
+	static std::uint64_t rotl(std::uint64_t x, int k)
+	{return (x << k) | (x >> (64 - k));}
+
+	std::uint64_t state[4];
+};
+
+// The kinds of synthetic reference strings "workloadGenerator" can make.
+enum class workloadType {uniform, zipf, scan, loop, mixed};
+
+// This class makes synthetic reference strings, one reference at a time, from a seed, so benchmarks can be repeated exactly.
+//  uniform: every one of "pages" pages is equally likely.
+//  zipf:    page 'k' (from 0) is referenced in proportion to 1 / (k + 1)^skew. A skew of 0 is uniform; around 1 is typical of real caches.
+//  scan:    a sequential scan that never repeats a page.
+//  loop:    pages 0, 1, ... "pages" - 1 over and over (the worst case for LRU with fewer frames than that).
+//  mixed:   phases of "phase" references that take turns being zipf, scan, zipf and loop, with the scan using pages of its own.
+//================================================================================================================
+class workloadGenerator
+{
+ public:
+	void reset(workloadType ptype, unsigned int ppages, double pskew, std::uint64_t seed, unsigned long long pphase = 100000)
+	{
+	 type = ptype;
+	 pages = std::max(1u, ppages);
+	 phase = std::max(1ull, pphase);
+	 rng.reseed(seed);
+	 position = 0;
+	 scanposition = 0;
+	 loopposition = 0;
+	 cdf.clear();
+		if (type == workloadType::zipf || type == workloadType::mixed) // the cumulative distribution, searched once per reference.
+		{
+		 cdf.resize(pages);
+		 double sum = 0.0;
+			for (unsigned int k = 0; k < pages; k++)
+			{
+			 sum += 1.0 / std::pow((double)(k + 1), pskew);
+			 cdf[k] = sum;
+			}
+			for (double &c : cdf)
+			{c /= sum;}
+		}
+	}
+
+	int next()
+	{
+	 workloadType current = type;
+		if (type == workloadType::mixed)
+		{
+		 static const workloadType phases[4] = {workloadType::zipf, workloadType::scan, workloadType::zipf, workloadType::loop};
+		 current = phases[(position / phase) % 4];
+		}
+	 position++;
+		switch (current)
+		{
+		 case workloadType::uniform:
+			return (int)rng.below(pages);
+		 case workloadType::zipf:
+			return (int)std::min<std::size_t>(std::lower_bound(cdf.begin(), cdf.end(), rng.uniform()) - cdf.begin(), pages - 1);
+		 case workloadType::scan:
+			return (int)(((type == workloadType::mixed ? pages : 0) + scanposition++) & INT_MAX);
+		 default: // loop
+			{
+			 int page = (int)loopposition;
+			 loopposition = (loopposition + 1 < pages ? loopposition + 1 : 0);
+			 return page;
+			}
+		}
+	}
+
+	static const char *name(workloadType ptype)
+	{
+	 static const char *names[5] = {"uniform", "zipf", "scan", "loop", "mixed"};
+	 return names[(int)ptype];
+	}
+
+ private:
+	workloadType type;
+	unsigned int pages;
+	unsigned long long phase;
+	xoshiro256 rng;
+	unsigned long long position;
+	unsigned long long scanposition;
+	unsigned int loopposition;
+	std::vector<double> cdf;
+};
+
+// This function gets the input from the user, which is the reference string and how many rows (frames) it should be.
+//================================================================================================================
+int getInput(int &refstrcount, std::vector<int> &refstr, int &framecount, const int &maxrefstrsize, const int &maxframesize)
+{
+ refstr.clear(); // this reference string is being cleared from the last inputted values, to accept the new reference string.
+ std::string line, selectionnumber;
+ int numint, errorcount;
+ refstrcount = 0; // initialization.
+ 
+ numint = 0;
+ std::cout << "Would you like to generate a random reference string (1) or to enter a reference string (2)?\n";
+	while (numint != 1 && numint != 2)
+	{
+	 cin_custom(selectionnumber);
+		if (strToInt(selectionnumber, numint) != 0)
+		{std::cout << "This is not a valid input. Please select either \"1\" or \"2\":\n";}
+		else 
+		{
+			if (numint != 1 && numint != 2)
+			{std::cout << "The number you selected was not \"1\" or \"2\". Please try again:\n";}
+		}
+	}
+	
+ std::cout << std::endl;
+	
+	if (numint == 1)
+	{
+	 numint = 0;
+	 std::cout << "Please enter the number of reference string elements (between 1 and " << maxrefstrsize << ")\n";
+		while (numint < 1 || numint > maxrefstrsize)
+		{
+		 cin_custom(selectionnumber);
+			if (strToInt(selectionnumber, numint) != 0)
+			{std::cout << "This is not a valid input. Please select number between \"1\" and \"" << maxrefstrsize << "\":\n";}
+			else
+			{
+				if (numint < 1 || numint > maxrefstrsize)
+				{std::cout << "The number you selected was not between \"1\" and \"" << maxrefstrsize << "\". Please try again:\n";}
+			}
+		}
+	 refstrcount = numint;
+	 workloadGenerator random;
+	 random.reset(workloadType::uniform, 10, 0.0, (std::uint64_t)std::time(NULL));
+	 std::cout << std::endl;
+		for (int i = 0; i < refstrcount; i++)
+		{
+		 refstr.push_back(random.next());
+		 std::cout << refstr[i];
+			if((i + 1) < refstrcount)
+			{std::cout << " ";}
+		}
+	 std::cout << std::endl;
+	}
+	
+	else // numint = 2
+	{
+	 errorcount = 1; // Temporarily set to one so while loop works, without the need of a do-while loop.
+		while (errorcount)
+		{
+		 refstr.clear(); // this reference string is being cleared from the last inputted values, to accept the new reference string.
+		 refstrcount = 0;
+		 errorcount = 0; // Now that we're inside the while loop, we start with zero errors.
+		 std::string num;
+		 std::cout << "Enter numbers separated by spaces:\n\n";
+		 getline(std::cin, line);
+		 remove_extra_whitespaces(line);
+		 trim(line);
+		 std::stringstream  lineStream(line);
+			while (getline(lineStream, num, ' ')) // the 'space' is the delimiter
+			{
+				if (strToInt(num, numint) != 0)
+				{
+				 errorcount++;
+				 std::cout << "\"" << num << "\"" << " is not an integer!\n";
+				}
+				else
+				{
+					if (num.size() > 4) // Number is most likely too big to fit in an 'int'.
+				    {
+					 errorcount++;
+					 std::cout << "\"" << num << "\"" << " is too big!\n";
+				    }
+					else
+					{
+					    if (numint >= 0 && numint <= 9)
+					    {
+						 refstr.push_back(numint); // place next number on the back of the stack, which will be used in alogoithm calculations.
+						 refstrcount++;
+					    }
+					    else
+					    {
+						 errorcount++;
+						 std::cout << "\"" << numint << "\"" << " is out of range! Number must be between 0-9.\n";
+					    }
+					}
+				}
+			}
+			if (refstrcount < 1 || refstrcount > maxrefstrsize)
+			{
+			 errorcount++;
+			 std::cout << "The amount of reference strings you entered was not between \"1\" and \"" << maxrefstrsize << "\". Please try again:\n";
+			}
+			if (errorcount)
+			{std::cout << "There were " << errorcount << " errors! Please try again!\n";}
+		}
+	}
+ 
+ std::cout << std::endl;
+ 
+ numint = 0;
+ std::cout << "Please enter the number of the frames (between 1 and " << maxframesize << ")\n";
+	while (numint < 1 || numint > maxframesize)
+	{
+	 cin_custom(selectionnumber);
+		if (strToInt(selectionnumber, numint) != 0)
+		{std::cout << "This is not a valid input. Please select number between \"1\" and \"" << maxframesize << "\":\n";}
+		else
+		{
+			if (numint < 1 || numint > maxframesize)
+			{std::cout << "The number you selected was not between \"1\" and \"" << maxframesize << "\". Please try again:\n";}
+		}
+	}
+ // min() is used here just in case refstrcount (# of elements in reference string) is less than the number of frames in each cache line.
+ framecount = std::min(numint, refstrcount);
+ return 0; // there were no problems with the number of reference strings.
+}
+
+// This class maps a whole file into memory, read only, so a trace can be parsed straight from the page cache.
+// Where "mmap" isn't available, the file is read into one buffer instead. Either way "data()" and "size()" work the same.
+//================================================================================================================
+class mappedFile
+{
+ public:
+	mappedFile() : filedata(nullptr), filesize(0){}
+	mappedFile(const mappedFile &) = delete;
+	mappedFile &operator=(const mappedFile &) = delete;
+	~mappedFile()
+	{close();}
+
+	int open(const std::string &path) // returns 0 if the file was mapped, 1 if it couldn't be opened, 2 if it couldn't be read.
+	{
+	 close();
+#if defined(_WIN32)
+	 std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{return 1;}
+	 filesize = (std::size_t)file.tellg();
+	 fallback.resize(filesize);
+	 file.seekg(0);
+		if (filesize > 0 && !file.read(fallback.data(), filesize))
+		{return 2;}
+	 filedata = fallback.data();
+#else
+	 int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+		{return 1;}
+	 struct stat st;
+		if (fstat(fd, &st) != 0)
+		{
+		 ::close(fd);
+		 return 2;
+		}
+	 filesize = (std::size_t)st.st_size;
+		if (filesize > 0)
+		{
+		 void *addr = mmap(nullptr, filesize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr == MAP_FAILED)
+			{
+			 ::close(fd);
+			 filesize = 0;
+			 return 2;
+			}
+		 madvise(addr, filesize, MADV_SEQUENTIAL); // only a hint, so it doesn't matter if it fails.
+		 filedata = (const char *)addr;
+		}
+	 ::close(fd); // the mapping stays valid after the file descriptor is closed.
+#endif
+	 return 0;
+	}
+
+	void close()
+	{
+#if defined(_WIN32)
+	 std::vector<char>().swap(fallback);
+#else
+		if (filedata != nullptr)
+		{munmap((void *)filedata, filesize);}
+#endif
+	 filedata = nullptr;
+	 filesize = 0;
+	}
+
+	const char *data() const
+	{return filedata;}
+
+	std::size_t size() const
+	{return filesize;}
+
+ private:
+	const char *filedata;
+	std::size_t filesize;
+#if defined(_WIN32)
+	std::vector<char> fallback;
+#endif
+};
+
+// This function is a fast replacement for "strToInt" when reading trace files. It never throws and never copies the token.
+// It reads one integer starting at "p", and leaves "p" at the first character after it.
+// Returns the same error codes as "strToInt": 0 = no error, 1 = not an integer, 2 = out of the range of an 'int'.
+//================================================================================================================
+int parseInt(const char *&p, const char *end, int &i)
+{
+ bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+	 negative = (*p == '-');
+	 p++;
+	}
+	if (p >= end || *p < '0' || *p > '9')
+	{return 1;}
+ long long value = 0;
+	while (p < end && *p >= '0' && *p <= '9')
+	{
+	 value = value * 10 + (*p - '0');
+		if (value > (long long)INT_MAX + 1) // keep going so "p" ends up after the whole number, but remember it's too big.
+		{value = (long long)INT_MAX + 2;}
+	 p++;
+	}
+	if (negative)
+	{value = -value;}
+	if (value > INT_MAX || value < INT_MIN)
+	{return 2;}
+	if (p < end && !std::isspace((unsigned char)*p) && *p != ',') // something like "12abc".
+	{return 1;}
+ i = (int)value;
+ return 0;
+}
+
+// This function reads one address for the page interner, starting at "p": an unsigned decimal number, or a hexadecimal one if it
+// starts with "0x" (like most address traces). It leaves "p" at the first character after it.
+// Returns 0 if there were no problems, 1 if it's not an address, or 2 if it doesn't fit in 64 bits.
+//================================================================================================================
+int parseAddress(const char *&p, const char *end, std::uint64_t &address)
+{
+ std::uint64_t base = 10;
+	if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
+	{
+	 base = 16;
+	 p += 2;
+	}
+ const char *digits = p;
+ std::uint64_t value = 0;
+ bool toobig = false;
+	while (p < end)
+	{
+	 std::uint64_t digit;
+		if (*p >= '0' && *p <= '9')
+		{digit = (std::uint64_t)(*p - '0');}
+		else if (base == 16 && *p >= 'a' && *p <= 'f')
+		{digit = (std::uint64_t)(*p - 'a' + 10);}
+		else if (base == 16 && *p >= 'A' && *p <= 'F')
+		{digit = (std::uint64_t)(*p - 'A' + 10);}
+		else
+		{break;}
+		if (value > (UINT64_MAX - digit) / base) // keep going so "p" ends up after the whole number, but remember it's too big.
+		{toobig = true;}
+	 value = value * base + digit;
+	 p++;
+	}
+	if (p == digits || (p < end && !std::isspace((unsigned char)*p) && *p != ',')) // nothing, or something like "12abc".
+	{return 1;}
+	if (toobig)
+	{return 2;}
+ address = value;
+ return 0;
+}
+
+// The formats a trace file can be stored in.
+enum class traceFormat {text, u32, u64, packed};
+
+// How "--export" writes the snapshots of every run: like the tables on the screen, as CSV, or as binary (laid out at "renderSnapshots").
+enum class exportFormat {text, csv, binary};
+
+// The "packed" format, for archiving traces. Everything is little endian:
+//
+//	"PRTRACE1"                     8 bytes
+//	number of references           64 bits
+//	references per block           32 bits (every block but the last is full)
+//	number of blocks               32 bits
+//	block offsets                  64 bits each, one per block plus one for the end of the file, from the start of the file
+//	blocks
+//
+// In each block, every page ID is stored as the difference from the one before it (from 0 for the first one in the block), zigzag
+// encoded so small negative differences are small too, as a varint: 7 bits per byte, lowest first, with the top bit set on every
+// byte but the last. Since no block depends on another, they can be decoded in parallel, or any one of them on its own.
+const char packedMagic[8] = {'P', 'R', 'T', 'R', 'A', 'C', 'E', '1'};
+const std::size_t packedHeaderSize = 24;
+const unsigned int packedBlockSize = 65536;
+
+std::uint64_t readLittleEndian(const unsigned char *p, unsigned int bytes)
+{
+ std::uint64_t value = 0;
+	for (unsigned int b = 0; b < bytes; b++)
+	{value |= (std::uint64_t)p[b] << (8 * b);}
+ return value;
+}
+
+void writeLittleEndian(std::vector<unsigned char> &out, std::uint64_t value, unsigned int bytes)
+{
+	for (unsigned int b = 0; b < bytes; b++)
+	{out.push_back((unsigned char)(value >> (8 * b)));}
+}
+
+// This function appends "count" page IDs to "out" as one block of the packed format.
+//================================================================================================================
+void encodePackedBlock(const int *pages, std::size_t count, std::vector<unsigned char> &out)
+{
+ long long previous = 0;
+	for (std::size_t i = 0; i < count; i++)
+	{
+	 long long delta = (long long)pages[i] - previous;
+	 previous = pages[i];
+	 std::uint64_t value = ((std::uint64_t)delta << 1) ^ (delta < 0 ? ~0ull : 0ull); // zigzag: 0, -1, 1, -2, 2... become 0, 1, 2, 3, 4...
+		while (value >= 0x80)
+		{
+		 out.push_back((unsigned char)(value | 0x80));
+		 value >>= 7;
+		}
+	 out.push_back((unsigned char)value);
+	}
+}
+
+// This function decodes one block of the packed format, from "p" up to "end", straight into "count" page IDs at "pages".
+// A difference between two 'int's needs 33 bits, so no varint can be more than 5 bytes long.
+// Returns 0 if the block held exactly "count" page IDs, or 1 if it's corrupt.
+//================================================================================================================
+int decodePackedBlock(const unsigned char *p, const unsigned char *end, int *pages, std::size_t count)
+{
+ long long previous = 0;
+	for (std::size_t i = 0; i < count; i++)
+	{
+	 std::uint64_t value = 0;
+		for (unsigned int shift = 0; ; shift += 7)
+		{
+			if (p >= end || shift > 28)
+			{return 1;}
+		 unsigned char byte = *p++;
+		 value |= (std::uint64_t)(byte & 0x7F) << shift;
+			if (byte < 0x80)
+			{break;}
+		}
+	 previous += (long long)(value >> 1) ^ -(long long)(value & 1);
+		if (previous < INT_MIN || previous > INT_MAX)
+		{return 1;}
+	 pages[i] = (int)previous;
+	}
+ return (p == end ? 0 : 1);
+}
+
+// This function reads a whole trace in the packed format, from the "size" bytes at "data", into "refstr". Every block is decoded
+// by whichever thread gets to it first, straight into its own part of "refstr".
+// Returns 0 if there were no problems. Otherwise "error" describes what went wrong.
+//================================================================================================================
+int decodePackedTrace(const std::string &path, const unsigned char *data, std::size_t size, std::vector<int> &refstr, std::string &error)
+{
+	if (size < packedHeaderSize || std::memcmp(data, packedMagic, sizeof(packedMagic)) != 0)
+	{
+	 error = "\"" + path + "\" is not a packed trace!";
+	 return 2;
+	}
+ std::uint64_t references = readLittleEndian(data + 8, 8);
+ std::uint64_t blocksize = readLittleEndian(data + 16, 4);
+ std::uint64_t blocks = readLittleEndian(data + 20, 4);
+	if (references > (std::uint64_t)INT_MAX)
+	{
+	 error = "\"" + path + "\" has more references than can be counted in an 'int'!";
+	 return 2;
+	}
+	if (blocksize == 0 || blocks != (references + blocksize - 1) / blocksize || (size - packedHeaderSize) / 8 < blocks + 1)
+	{
+	 error = "The header of \"" + path + "\" is corrupt!";
+	 return 2;
+	}
+ std::vector<std::uint64_t> offsets(blocks + 1);
+	for (std::size_t b = 0; b <= blocks; b++)
+	{
+	 offsets[b] = readLittleEndian(data + packedHeaderSize + 8 * b, 8);
+		if (offsets[b] < (b == 0 ? packedHeaderSize + 8 * (blocks + 1) : offsets[b - 1]) || offsets[b] > size)
+		{
+		 error = "The block offsets in \"" + path + "\" are corrupt!";
+		 return 2;
+		}
+	}
+	if (offsets[blocks] != size)
+	{
+	 error = "\"" + path + "\" doesn't end where its last block does!";
+	 return 2;
+	}
+ refstr.resize((std::size_t)references);
+ std::atomic<std::size_t> corrupt(blocks); // the first corrupt block found, if any.
+ parallelFor((std::size_t)blocks, 0, [&](std::size_t b)
+ {
+	std::size_t first = b * (std::size_t)blocksize;
+	std::size_t count = std::min<std::size_t>((std::size_t)blocksize, refstr.size() - first);
+	if (decodePackedBlock(data + offsets[b], data + offsets[b + 1], refstr.data() + first, count) != 0)
+	{
+	 std::size_t none = blocks;
+	 corrupt.compare_exchange_strong(none, b);
+	}
+ });
+	if (corrupt != blocks)
+	{
+	 error = "Block " + std::to_string(corrupt) + " of \"" + path + "\" is corrupt!";
+	 return 2;
+	}
+ return 0;
+}
+
+// This function loads a whole reference string from a trace file. Page IDs can be anything in the range of an 'int'.
+// "u32" page IDs are stored bit for bit, so every one of the 2^32 values stays distinct. "u64" page IDs must fit in 32 bits.
+// With an "interner", the trace holds raw addresses instead (any 64 bit value, and in text, decimal or "0x" hexadecimal), and each
+// one is replaced by the dense ID of its page. The interner keeps the addresses, so it can be used to display them afterwards.
+// Returns 0 if there were no problems. Otherwise "error" describes what went wrong.
+//================================================================================================================
+int loadTraceFile(const std::string &path, traceFormat format, int &refstrcount, std::vector<int> &refstr, std::string &error,
+                  pageInterner *interner = nullptr)
+{
+ refstr.clear();
+ std::vector<int>().swap(refstr);
+ refstrcount = 0;
+ mappedFile file;
+	if (file.open(path) != 0)
+	{
+	 error = "\"" + path + "\" could not be opened!";
+	 return 1;
+	}
+ const char *p = file.data();
+ const char *end = p + file.size();
+	if (format == traceFormat::text)
+	{
+	 refstr.reserve(file.size() / 2); // at least one separator per number, so this is the most there can be.
+	 int numint;
+	 std::uint64_t address;
+		while (p < end)
+		{
+			if (std::isspace((unsigned char)*p) || *p == ',')
+			{
+			 p++;
+			 continue;
+			}
+		 const char *token = p;
+			if (interner ? parseAddress(p, end, address) != 0 : parseInt(p, end, numint) != 0)
+			{
+			 while (p < end && !std::isspace((unsigned char)*p) && *p != ',') {p++;}
+			 error = "\"" + std::string(token, p) + (interner ? "\" is not a 64 bit address!" : "\" is not an integer in the range of an 'int'!");
+			 return 2;
+			}
+			if (interner && (numint = interner->intern(address)) < 0)
+			{
+			 error = "\"" + path + "\" has more distinct pages than can be counted in an 'int'!";
+			 return 2;
+			}
+		 refstr.push_back(numint);
+		}
+	 refstr.shrink_to_fit();
+	}
+	else if (format == traceFormat::packed)
+	{
+	 int status = decodePackedTrace(path, (const unsigned char *)p, file.size(), refstr, error);
+		if (status != 0)
+		{return status;}
+		for (std::size_t i = 0; interner && i < refstr.size(); i++) // the page IDs are taken as addresses, bit for bit, like "u32".
+		{
+		 int id = interner->intern((std::uint32_t)refstr[i]);
+			if (id < 0)
+			{
+			 error = "\"" + path + "\" has more distinct pages than can be counted in an 'int'!";
+			 return 2;
+			}
+		 refstr[i] = id;
+		}
+	}
+	else
+	{
+	 std::size_t width = (format == traceFormat::u32 ? sizeof(std::uint32_t) : sizeof(std::uint64_t));
+		if (file.size() % width != 0)
+		{
+		 error = "\"" + path + "\" is not a whole number of " + std::to_string(width * 8) + " bit page IDs!";
+		 return 2;
+		}
+	 std::size_t count = file.size() / width;
+	 refstr.resize(count);
+		if (interner)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+			 std::uint64_t address;
+				if (format == traceFormat::u32)
+				{
+				 std::uint32_t numint;
+				 std::memcpy(&numint, p + i * width, width);
+				 address = numint;
+				}
+				else
+				{std::memcpy(&address, p + i * width, width);}
+			 int id = interner->intern(address);
+				if (id < 0)
+				{
+				 error = "\"" + path + "\" has more distinct pages than can be counted in an 'int'!";
+				 return 2;
+				}
+			 refstr[i] = id;
+			}
+		}
+		else if (format == traceFormat::u32)
+		{
+		 std::memcpy(refstr.data(), p, count * width); // page IDs are kept bit for bit.
+		}
+		else
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+			 std::uint64_t numint;
+			 std::memcpy(&numint, p + i * width, width);
+				if (numint > UINT32_MAX)
+				{
+				 error = "page ID " + std::to_string(numint) + " does not fit in 32 bits! (Addresses can be read with --page-size.)";
+				 return 2;
+				}
+			 refstr[i] = (int)(std::uint32_t)numint;
+			}
+		}
+	}
+	if (refstr.size() > (std::size_t)INT_MAX)
+	{
+	 error = "\"" + path + "\" has more references than can be counted in an 'int'!";
+	 return 2;
+	}
+ refstrcount = (int)refstr.size();
+	if (refstrcount < 1)
+	{
+	 error = "\"" + path + "\" has no references in it!";
+	 return 2;
+	}
+ return 0;
+}
+
+// This function saves a reference string to "path" as raw, native endian "u32" page IDs: the one format "sharedTrace" doesn't copy.
+// Returns 0 if it was written. Otherwise "error" describes what went wrong.
+//================================================================================================================
+int saveUnpackedTraceFile(const std::string &path, const traceView &refstr, std::string &error)
+{
+ std::FILE *file = std::fopen(path.c_str(), "wb");
+	if (!file)
+	{
+	 error = "\"" + path + "\" could not be created!";
+	 return 1;
+	}
+ bool written = (std::fwrite(refstr.data(), sizeof(int), refstr.size(), file) == refstr.size());
+	if (std::fclose(file) != 0 || !written)
+	{
+	 error = "\"" + path + "\" could not be written!";
+	 return 2;
+	}
+ return 0;
+}
+
+// This is a HELPER class that holds a whole trace for as long as it's being run, and lets every run look at it through a "traceView".
+// A "u32" trace of page IDs (not addresses) is already what the algorithms read, so it's mapped from its file, read only, and never
+// copied. Every thread of a sweep, and every other process running on the same file at the same time, shares the one copy the
+// operating system keeps of it (in /dev/shm, that copy never touches the disk). Any other trace is decoded into memory of its own.
+class sharedTrace
+{
+ public:
+ sharedTrace(){}
+	sharedTrace(const sharedTrace &) = delete;
+	sharedTrace &operator=(const sharedTrace &) = delete;
+
+	// Takes the same arguments as "loadTraceFile", and returns the same thing.
+	int load(const std::string &path, traceFormat format, int &refstrcount, std::string &error, pageInterner *interner = nullptr)
+	{
+	 file.close();
+	 owned.clear();
+	 pages = traceView();
+	 refstrcount = 0;
+		if (format != traceFormat::u32 || interner != nullptr)
+		{
+		 int status = loadTraceFile(path, format, refstrcount, owned, error, interner);
+			if (status == 0)
+			{pages = traceView(owned);}
+		 return status;
+		}
+		if (file.open(path) != 0)
+		{
+		 error = "\"" + path + "\" could not be opened!";
+		 return 1;
+		}
+		if (file.size() % sizeof(std::uint32_t) != 0)
+		{
+		 error = "\"" + path + "\" is not a whole number of 32 bit page IDs!";
+		 return 2;
+		}
+		if (file.size() / sizeof(std::uint32_t) > (std::size_t)INT_MAX)
+		{
+		 error = "\"" + path + "\" has more references than can be counted in an 'int'!";
+		 return 2;
+		}
+	 refstrcount = (int)(file.size() / sizeof(std::uint32_t));
+		if (refstrcount < 1)
+		{
+		 error = "\"" + path + "\" has no references in it!";
+		 return 2;
+		}
+	 pages = traceView(reinterpret_cast<const int *>(file.data()), (std::size_t)refstrcount); // page IDs are kept bit for bit, like "loadTraceFile".
+	 return 0;
+	}
+
+	const traceView &view() const
+	{return pages;}
+
+ private:
+	mappedFile file; // the trace, when it's looked at where it is,
+	std::vector<int> owned; // or its page IDs, when they had to be decoded.
+	traceView pages;
+};
+
+// This function saves a reference string to "path" in the packed format, with the blocks encoded on "threadcount" threads
+// (0 = one per hardware thread). Returns the size of the file in "bytes", and 0 if it was written. Otherwise "error" describes what went wrong.
+//================================================================================================================
+int saveTraceFile(const std::string &path, const traceView &refstr, unsigned int threadcount, std::uint64_t &bytes, std::string &error)
+{
+ std::size_t blocks = (refstr.size() + packedBlockSize - 1) / packedBlockSize;
+ std::vector<std::vector<unsigned char>> encoded(blocks);
+ parallelFor(blocks, threadcount, [&](std::size_t b)
+ {
+	std::size_t first = b * packedBlockSize;
+	std::size_t count = std::min<std::size_t>(packedBlockSize, refstr.size() - first);
+	encoded[b].reserve(count * 2);
+	encodePackedBlock(refstr.data() + first, count, encoded[b]);
+ });
+ std::vector<unsigned char> header(packedMagic, packedMagic + sizeof(packedMagic));
+ writeLittleEndian(header, refstr.size(), 8);
+ writeLittleEndian(header, packedBlockSize, 4);
+ writeLittleEndian(header, blocks, 4);
+ bytes = packedHeaderSize + 8 * (blocks + 1);
+	for (std::size_t b = 0; b <= blocks; b++)
+	{
+	 writeLittleEndian(header, bytes, 8);
+		if (b < blocks)
+		{bytes += encoded[b].size();}
+	}
+ std::FILE *file = std::fopen(path.c_str(), "wb");
+	if (!file)
+	{
+	 error = "\"" + path + "\" could not be created!";
+	 return 1;
+	}
+ bool written = (std::fwrite(header.data(), 1, header.size(), file) == header.size());
+	for (std::size_t b = 0; written && b < blocks; b++)
+	{written = (std::fwrite(encoded[b].data(), 1, encoded[b].size(), file) == encoded[b].size());}
+	if (std::fclose(file) != 0 || !written)
+	{
+	 error = "\"" + path + "\" could not be written!";
+	 return 2;
+	}
+ return 0;
+}
+
+// Everything that can be set on the command line. Without any arguments, the program runs interactively like before.
+struct commandLine
+{
+ std::string tracefile;
+ traceFormat format = traceFormat::text;
+ std::string packfile; // when not empty, save the trace here in the packed format, instead of running anything.
+ std::string unpackfile; // when not empty, save the trace here as "u32" page IDs, instead of running anything.
+ std::string exportfile; // when not empty, write the snapshots of every run on the trace here, instead of to the screen.
+ exportFormat exportformat = exportFormat::text;
+ std::string evictionsfile; // when not empty, write every eviction of every run on the trace here, as CSV.
+ std::vector<int> framesizes = {3}; // every number of frames to run each algorithm with.
+ unsigned int threads = 0; // 0 = one per hardware thread.
+ bool snapshots = false; // stats-only unless asked for, since traces are usually far too long to display.
+ bool summary = false; // one line of statistics per algorithm, instead of a table each.
+ int mrcframes = 0; // when more than 0, print the LRU and OPT miss ratio curves for 1 to "mrcframes" frames instead.
+ bool profile = false; // print the trace's reuse distances, working set sizes and page frequencies instead.
+ std::vector<int> profilewindows = {100, 1000, 10000, 100000}; // the windows of the working set sizes, in references.
+ double shardsrate = 0.0; // when more than 0, the miss ratio curves are estimated from a hashed sample of the pages (SHARDS).
+ std::size_t shardsbudget = 0; // when more than 0, the LRU sample never tracks more than this many pages.
+ bool shardsexact = false; // also run the exact curves, and report how far off the sampled ones were.
+ bool bench = false; // time every algorithm on synthetic workloads instead of a trace file.
+ std::vector<workloadType> workloads = {workloadType::uniform, workloadType::zipf, workloadType::scan, workloadType::loop, workloadType::mixed};
+ int length = 1000000; // references per synthetic workload.
+ int pages = 10000; // distinct pages per synthetic workload.
+ double skew = 0.99; // zipf skew.
+ std::uint64_t seed = 42;
+ int repeat = 1; // runs of each algorithm on each workload, when benchmarking. Only the last one is reported.
+ std::vector<std::string> sweepfiles; // when not empty, run the chosen policies with every number of frames on each of these traces.
+ std::vector<std::string> policies; // names of algorithms to sweep. Empty means all of them.
+ bool json = false; // sweep (and stream) results as JSON lines instead of CSV.
+ bool stream = false; // run the online algorithms on page IDs read from standard input, as they arrive.
+ int window = 100000; // references per reported window, when streaming.
+ int lookahead = 10000; // how far ahead the bounded lookahead "Opt" can see.
+ std::string tenantfile; // when not empty, simulate this (process, page) tagged trace under global and local replacement.
+ int wswindow = 1000; // the working set window of each tenant, in its own references.
+ int pffinterval = 100; // the page fault frequency allocator's threshold, in each tenant's own references.
+ int pageshift = -1; // when 0 or more, traces hold addresses, interned into dense page IDs after shifting them right by this many bits.
+};
+
+// This function splits a comma separated list, like "LRU,ARC", and adds each (non-empty) item to "items".
+//================================================================================================================
+void splitList(const std::string &list, std::vector<std::string> &items)
+{
+ std::string::size_type first = 0;
+	while (first <= list.size())
+	{
+	 std::string::size_type last = list.find(',', first);
+		if (last == std::string::npos)
+		{last = list.size();}
+		if (last > first)
+		{items.push_back(list.substr(first, last - first));}
+	 first = last + 1;
+	}
+}
+
+// The most frame sizes a "--frames" list can hold, once its ranges are written out.
+const std::size_t maxFrameSizes = 1u << 20;
+
+// This function reads a list of frame sizes, like "3", "1,2,4" or "1-16" (or any mix of those), into "framesizes".
+// Returns 0 if there were no problems, and 1 if the list was wrong or held more than "maxFrameSizes" sizes.
+//================================================================================================================
+int parseFrameList(const std::string &list, std::vector<int> &framesizes)
+{
+ framesizes.clear();
+ const char *p = list.c_str();
+ const char *end = p + list.size();
+	while (p < end)
+	{
+	 int first, last;
+	 const char *token = p;
+		while (p < end && *p != ',' && *p != '-') {p++;}
+		if (parseInt(token, p, first) != 0)
+		{return 1;}
+	 last = first;
+		if (p < end && *p == '-')
+		{
+		 token = ++p;
+			while (p < end && *p != ',') {p++;}
+			if (parseInt(token, p, last) != 0)
+			{return 1;}
+		}
+		if (first < 1 || last < first || (std::size_t)(last - first) >= maxFrameSizes - framesizes.size())
+		{return 1;}
+		for (int f = first; f < last; f++) // not "f <= last", which never ends when "last" is INT_MAX.
+		{framesizes.push_back(f);}
+	 framesizes.push_back(last);
+		if (p < end) // skip the ','
+		{p++;}
+	}
+ return (framesizes.empty() ? 1 : 0);
+}
+
+// This function reads the command line into "options". Returns 0 if there were no problems.
+//================================================================================================================
+int parseCommandLine(int argc, char *argv[], commandLine &options)
+{
+	for (int a = 1; a < argc; a++)
+	{
+	 std::string arg = argv[a];
+	 bool hasvalue = (a + 1 < argc);
+		if (arg == "--trace" && hasvalue)
+		{options.tracefile = argv[++a];}
+		else if (arg == "--format" && hasvalue)
+		{
+		 std::string value = argv[++a];
+			if (value == "text")
+			{options.format = traceFormat::text;}
+			else if (value == "u32")
+			{options.format = traceFormat::u32;}
+			else if (value == "u64")
+			{options.format = traceFormat::u64;}
+			else if (value == "packed")
+			{options.format = traceFormat::packed;}
+			else
+			{
+			 std::cerr << "\"" << value << "\" is not a trace format! Use \"text\", \"u32\", \"u64\" or \"packed\".\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--frames" && hasvalue)
+		{
+			if (parseFrameList(argv[++a], options.framesizes) != 0)
+			{
+			 std::cerr << "The number of frames must be a list like \"3\", \"1,2,4\" or \"1-16\", and each must be at least 1.\n"
+			             "No more than " << maxFrameSizes << " frame sizes can be given in all.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--threads" && hasvalue)
+		{
+		 const char *value = argv[++a];
+		 int numint;
+			if (parseInt(value, value + std::strlen(value), numint) != 0 || numint < 0)
+			{
+			 std::cerr << "The number of threads must be 0 (one per hardware thread) or more.\n";
+			 return 1;
+			}
+		 options.threads = (unsigned int)numint;
+		}
+		else if (arg == "--snapshots")
+		{options.snapshots = true;}
+		else if (arg == "--shards-rate" && hasvalue)
+		{
+		 char *end;
+		 options.shardsrate = std::strtod(argv[++a], &end);
+			if (*end != '\0' || !(options.shardsrate > 0.0 && options.shardsrate <= 1.0))
+			{
+			 std::cerr << "The sampling rate must be more than 0 and no more than 1.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--shards-budget" && hasvalue)
+		{
+		 const char *value = argv[++a];
+		 int numint;
+			if (parseInt(value, value + std::strlen(value), numint) != 0 || numint < 1)
+			{
+			 std::cerr << "The sample budget must be at least 1 page.\n";
+			 return 1;
+			}
+		 options.shardsbudget = (std::size_t)numint;
+		}
+		else if (arg == "--bench")
+		{options.bench = true;}
+		else if (arg == "--workload" && hasvalue)
+		{
+		 std::string value = argv[++a];
+		 options.workloads.clear();
+			for (int w = 0; w < 5; w++)
+			{
+				if (value == "all" || value == workloadGenerator::name((workloadType)w))
+				{options.workloads.push_back((workloadType)w);}
+			}
+			if (options.workloads.empty())
+			{
+			 std::cerr << "\"" << value << "\" is not a workload! Use \"uniform\", \"zipf\", \"scan\", \"loop\", \"mixed\" or \"all\".\n";
+			 return 1;
+			}
+		}
+		else if ((arg == "--length" || arg == "--pages" || arg == "--seed" || arg == "--repeat") && hasvalue)
+		{
+		 const char *value = argv[++a];
+		 int numint;
+			if (parseInt(value, value + std::strlen(value), numint) != 0 || numint < (arg == "--seed" ? 0 : 1))
+			{
+			 std::cerr << arg << " must be " << (arg == "--seed" ? "0 or more" : "at least 1") << ".\n";
+			 return 1;
+			}
+			if (arg == "--length")
+			{options.length = numint;}
+			else if (arg == "--pages")
+			{options.pages = numint;}
+			else if (arg == "--repeat")
+			{options.repeat = numint;}
+			else
+			{options.seed = (std::uint64_t)numint;}
+		}
+		else if (arg == "--skew" && hasvalue)
+		{
+		 char *end;
+		 options.skew = std::strtod(argv[++a], &end);
+			if (*end != '\0' || !(options.skew >= 0.0))
+			{
+			 std::cerr << "The zipf skew must be 0 or more.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--shards-exact")
+		{options.shardsexact = true;}
+		else if (arg == "--stream")
+		{options.stream = true;}
+		else if (arg == "--window" && hasvalue)
+		{
+		 const char *value = argv[++a];
+			if (parseInt(value, value + std::strlen(value), options.window) != 0 || options.window < 1)
+			{
+			 std::cerr << "The window must be at least 1 reference.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--tenants" && hasvalue)
+		{options.tenantfile = argv[++a];}
+		else if ((arg == "--ws-window" || arg == "--pff-interval") && hasvalue)
+		{
+		 const char *value = argv[++a];
+		 int &references = (arg == "--ws-window" ? options.wswindow : options.pffinterval);
+			if (parseInt(value, value + std::strlen(value), references) != 0 || references < 1)
+			{
+			 std::cerr << "The " << (arg == "--ws-window" ? "working set window" : "page fault frequency interval") << " must be at least 1 reference.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--lookahead" && hasvalue)
+		{
+		 const char *value = argv[++a];
+			if (parseInt(value, value + std::strlen(value), options.lookahead) != 0 || options.lookahead < 0)
+			{
+			 std::cerr << "The lookahead must be 0 references or more.\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--pack" && hasvalue)
+		{options.packfile = argv[++a];}
+		else if (arg == "--unpack" && hasvalue)
+		{options.unpackfile = argv[++a];}
+		else if (arg == "--export" && hasvalue)
+		{options.exportfile = argv[++a];}
+		else if (arg == "--evictions" && hasvalue)
+		{options.evictionsfile = argv[++a];}
+		else if (arg == "--export-format" && hasvalue)
+		{
+		 std::string value = argv[++a];
+			if (value == "text")
+			{options.exportformat = exportFormat::text;}
+			else if (value == "csv")
+			{options.exportformat = exportFormat::csv;}
+			else if (value == "binary")
+			{options.exportformat = exportFormat::binary;}
+			else
+			{
+			 std::cerr << "\"" << value << "\" is not an export format! Use \"text\", \"csv\" or \"binary\".\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--summary")
+		{options.summary = true;}
+		else if (arg == "--page-size" && hasvalue)
+		{
+		 std::string value = argv[++a];
+		 const char *digits = value.c_str();
+		 const char *end = digits + value.size();
+		 unsigned long long unit = 1;
+			if (!value.empty() && std::isalpha((unsigned char)value.back()))
+			{
+			 char suffix = (char)std::toupper((unsigned char)value.back());
+			 unit = (suffix == 'K' ? 1ull << 10 : suffix == 'M' ? 1ull << 20 : suffix == 'G' ? 1ull << 30 : 0);
+			 end--;
+			}
+		 int size;
+			if (unit == 0 || parseInt(digits, end, size) != 0 || size < 1 || (size & (size - 1)) != 0)
+			{
+			 std::cerr << "\"" << value << "\" is not a page size! Use a power of 2 in bytes, like \"4K\", \"2M\" or \"1G\","
+			           << " or \"1\" if the trace already holds page numbers.\n";
+			 return 1;
+			}
+		 options.pageshift = 0;
+			while ((1ull << options.pageshift) < (unsigned long long)size * unit)
+			{options.pageshift++;}
+		}
+		else if (arg == "--sweep" && hasvalue)
+		{splitList(argv[++a], options.sweepfiles);}
+		else if (arg == "--policies" && hasvalue)
+		{splitList(argv[++a], options.policies);}
+		else if (arg == "--output" && hasvalue)
+		{
+		 std::string value = argv[++a];
+			if (value != "csv" && value != "json")
+			{
+			 std::cerr << "\"" << value << "\" is not an output format! Use \"csv\" or \"json\".\n";
+			 return 1;
+			}
+		 options.json = (value == "json");
+		}
+		else if (arg == "--profile")
+		{options.profile = true;}
+		else if (arg == "--profile-windows" && hasvalue)
+		{
+			if (parseFrameList(argv[++a], options.profilewindows) != 0)
+			{
+			 std::cerr << "\"" << argv[a] << "\" is not a valid list of windows! Use something like \"100,1000\" or \"1-10\".\n";
+			 return 1;
+			}
+		}
+		else if (arg == "--mrc" && hasvalue)
+		{
+		 const char *value = argv[++a];
+			if (parseInt(value, value + std::strlen(value), options.mrcframes) != 0 || options.mrcframes < 1)
+			{
+			 std::cerr << "The largest number of frames for the miss ratio curve must be at least 1.\n";
+			 return 1;
+			}
+		}
+		else
+		{
+		 std::cerr << "\"" << arg << "\" is not a valid argument (or is missing its value)!\n";
+		 return 1;
+		}
+	}
+	if (options.tracefile.empty() && !options.bench && options.sweepfiles.empty() && !options.stream && options.tenantfile.empty())
+	{
+	 std::cerr << "A trace file is required: --trace <file>, --sweep <file>[,<file>...] or --tenants <file>\n";
+	 return 1;
+	}
+	if (options.profile && options.tracefile.empty())
+	{
+	 std::cerr << "Only a trace file can be profiled: --trace <file> --profile\n";
+	 return 1;
+	}
+	if (!options.packfile.empty() && options.tracefile.empty())
+	{
+	 std::cerr << "Only a trace file can be packed: --trace <file> --pack <file>\n";
+	 return 1;
+	}
+	if (!options.unpackfile.empty() && options.tracefile.empty())
+	{
+	 std::cerr << "Only a trace file can be unpacked: --trace <file> --unpack <file>\n";
+	 return 1;
+	}
+	if (!options.exportfile.empty() && (options.tracefile.empty() || !options.packfile.empty() || !options.unpackfile.empty() || options.profile || options.mrcframes > 0))
+	{
+	 std::cerr << "Only the runs on a trace file can be exported: --trace <file> --export <file>\n";
+	 return 1;
+	}
+	if (!options.evictionsfile.empty() && (options.tracefile.empty() || !options.packfile.empty() || !options.unpackfile.empty() || options.profile || options.mrcframes > 0))
+	{
+	 std::cerr << "Only the evictions of the runs on a trace file can be logged: --trace <file> --evictions <file>\n";
+	 return 1;
+	}
+	if (options.stream && options.format == traceFormat::packed)
+	{
+	 std::cerr << "A packed trace can't be streamed. Use --trace or --sweep with it instead.\n";
+	 return 1;
+	}
+	if ((options.shardsrate > 0.0 || options.shardsbudget > 0) && options.mrcframes < 1)
+	{
+	 std::cerr << "Sampling only applies to miss ratio curves: --mrc <frames>\n";
+	 return 1;
+	}
+	if (!options.policies.empty() && (options.bench || !options.packfile.empty() || !options.unpackfile.empty() || options.profile || options.mrcframes > 0))
+	{
+	 std::cerr << "Policies can only be chosen for the runs on a trace file, a sweep, a stream or tenants: --policies <name>[,<name>...]\n";
+	 return 1;
+	}
+ return 0;
+}
+
+// These functions quote a string for a CSV field or a JSON string. Trace paths can have commas, quotes or backslashes (Windows) in them.
+//================================================================================================================
+std::string csvField(const std::string &value)
+{
+	if (value.find_first_of(",\"\r\n") == std::string::npos)
+	{return value;}
+ std::string quoted = "\"";
+	for (const char &c : value)
+	{quoted += (c == '"' ? std::string("\"\"") : std::string(1, c));}
+ return quoted + "\"";
+}
+
+std::string jsonString(const std::string &value)
+{
+ std::string quoted = "\"";
+	for (const char &c : value)
+	{
+		if (c == '"' || c == '\\')
+		{quoted += '\\';}
+		if ((unsigned char)c < 0x20)
+		{
+		 char escaped[8];
+		 std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)(unsigned char)c);
+		 quoted += escaped;
+		}
+		else
+		{quoted += c;}
+	}
+ return quoted + "\"";
+}
+
+// This function renders the snapshots of every run in "results" for "--export", each run on a thread of its own (see "parallelFor").
+// "csv" has a header, and then one row for each frame of each run: the algorithm, its number of frames, the frame, and the page in
+// that frame after each snapshot, as many as there were (in hexadecimal, when the pages stand for addresses).
+// "binary" is native endian: "PRSNAPS1", the number of runs (u32), and then for each run the length of its algorithm's name (u32),
+// the name, its frames, page faults, hits and pages per snapshot (u32 each), the number of snapshots (u64), and then the page IDs
+// of every snapshot, one after another (i32 each).
+//================================================================================================================
+void renderSnapshots(std::vector<std::shared_ptr<algorithmType>> &results, exportFormat format, unsigned int threadcount, textBuffer &out)
+{
+ std::vector<textBuffer> runs(results.size());
+ parallelFor(results.size(), threadcount, [&](std::size_t r)
+ {
+	algorithmType &alg = *results[r];
+	const snapshotBuffer &snapshots = alg.getVector();
+	textBuffer &run = runs[r];
+	if (format == exportFormat::csv)
+	{
+	 std::string name = csvField(alg.getName());
+	 std::shared_ptr<const pageInterner> pagenames = alg.getPageNames();
+	 run.reserve((std::size_t)snapshots.width() * (snapshots.size() * (pagenames ? 12 : 4) + name.size() + 16));
+		for (unsigned int a = 0; a < snapshots.width(); a++)
+		{
+		 run << name << ',' << alg.getFrameFinalSize() << ',' << a;
+			for (std::size_t i = 0; i < snapshots.size(); i++)
+			{
+				if (pagenames)
+				{(run << ",0x").appendHex(pagenames->getAddress(snapshots[i][a]));}
+				else
+				{run << ',' << snapshots[i][a];}
+			}
+		 run << '\n';
+		}
+	}
+	else
+	{
+	 std::string name = alg.getName();
+	 std::uint32_t header[5] = {(std::uint32_t)name.size(), alg.getFrameFinalSize(), alg.getMiss(), alg.getHit(), snapshots.width()};
+	 std::uint64_t count = snapshots.size();
+	 run.reserve(sizeof(header) + name.size() + sizeof(count) + count * snapshots.width() * sizeof(int));
+	 run.appendBytes(&header[0], sizeof(header[0]));
+	 run.appendBytes(name.data(), name.size());
+	 run.appendBytes(&header[1], sizeof(header) - sizeof(header[0]));
+	 run.appendBytes(&count, sizeof(count));
+	 run.appendBytes(snapshots.data(), count * snapshots.width() * sizeof(int));
+	}
+ });
+	if (format == exportFormat::csv)
+	{out << "algorithm,frames,frame,pages\n";}
+	else
+	{
+	 std::uint32_t count = (std::uint32_t)results.size();
+	 out.appendBytes("PRSNAPS1", 8);
+	 out.appendBytes(&count, sizeof(count));
+	}
+	for (textBuffer &run : runs)
+	{out << run;}
+}
+
+// This function picks the algorithms named in "names" out of "algvector" (or all of them, if there are no names) into "chosen".
+// With "streamable", only algorithms that can be run one page at a time are allowed. Returns 0 if every name was found.
+//================================================================================================================
+int choosePolicies(std::vector<std::shared_ptr<algorithmType>> &algvector, const std::vector<std::string> &names, bool streamable,
+                   std::vector<std::shared_ptr<algorithmType>> &chosen)
+{
+ chosen.clear();
+	for (const std::string &name : names)
+	{
+	 std::vector<std::shared_ptr<algorithmType>>::iterator itr_alg = std::find_if(algvector.begin(), algvector.end(),
+	  [&name](const std::shared_ptr<algorithmType> &alg){return alg->getName() == name;});
+		if (itr_alg == algvector.end() || (streamable && !(*itr_alg)->getStreamable()))
+		{
+		 std::cerr << "\"" << name << "\" is not a" << (streamable ? "n online" : "") << " policy! Use any of:";
+			for (std::shared_ptr<algorithmType> &alg : algvector)
+			{
+				if (!streamable || alg->getStreamable())
+				{std::cerr << " \"" << alg->getName() << "\"";}
+			}
+		 std::cerr << std::endl;
+		 return 1;
+		}
+	 chosen.push_back(*itr_alg);
+	}
+	if (names.empty())
+	{
+		for (std::shared_ptr<algorithmType> &alg : algvector)
+		{
+			if (!streamable || alg->getStreamable())
+			{chosen.push_back(alg);}
+		}
+	}
+ return 0;
+}
+
+// This observer writes a CSV row for every eviction of one run ("alg") as it happens, for "--evictions": the algorithm, its number of frames,
+// the index of the reference that caused it, the frame, and the pages that left and came in (in hexadecimal, when the pages stand
+// for addresses). Rows are collected in a small buffer that is moved to a temporary file whenever it fills, so a run of any length
+// only keeps that much in memory. Without a temporary file (if one can't be made), every row stays in memory instead.
+class evictionWriter : public algorithmObserver
+{
+ public:
+	explicit evictionWriter(algorithmType &alg) : spill(std::tmpfile()), failed(false), pagenames(alg.getPageNames())
+	{
+	 textBuffer start; // every row of the run starts the same.
+	 start << csvField(alg.getName()) << ',' << alg.getFrameFinalSize() << ',';
+	 prefix = start.str();
+	}
+
+	~evictionWriter()
+	{
+		if (spill)
+		{std::fclose(spill);}
+	}
+
+	evictionWriter(const evictionWriter &) = delete;
+	evictionWriter &operator=(const evictionWriter &) = delete;
+
+	virtual void onEvict(const algorithmType &, int position, unsigned int frame, int evicted, int page) override
+	{
+	 rows << prefix << position << ',' << frame;
+		if (pagenames)
+		{
+		 (rows << ",0x").appendHex(pagenames->getAddress(evicted));
+		 (rows << ",0x").appendHex(pagenames->getAddress(page));
+		}
+		else
+		{rows << ',' << evicted << ',' << page;}
+	 rows << '\n';
+		if (spill && rows.size() >= bufferSize)
+		{flush();}
+	}
+
+	// Copies every row, in order, to the end of "file". Returns 0 if all of them were written.
+	int copyTo(std::FILE *file)
+	{
+		if (spill)
+		{
+		 flush();
+		 std::rewind(spill);
+		 std::vector<char> chunk(bufferSize);
+		 std::size_t count;
+			while ((count = std::fread(chunk.data(), 1, chunk.size(), spill)) > 0)
+			{
+				if (std::fwrite(chunk.data(), 1, count, file) != count)
+				{return 1;}
+			}
+			if (std::ferror(spill))
+			{failed = true;}
+		}
+		else if (rows.writeTo(file) != 0)
+		{return 1;}
+	 return (failed ? 1 : 0);
+	}
+
+ private:
+	static const std::size_t bufferSize = 1 << 16;
+
+	void flush()
+	{
+		if (std::fwrite(rows.str().data(), 1, rows.size(), spill) != rows.size())
+		{failed = true;}
+	 rows.clear();
+	}
+
+	std::FILE *spill;
+	bool failed;
+	textBuffer rows;
+	std::string prefix;
+	std::shared_ptr<const pageInterner> pagenames;
+};
+
+// This function writes the rows of every "evictionWriter" in "evictions" (one for each run, in order) to "filename", after a header.
+// Returns 0 if the file was written.
+//================================================================================================================
+int writeEvictions(const std::string &filename, const std::vector<std::shared_ptr<evictionWriter>> &evictions)
+{
+ std::FILE *file = std::fopen(filename.c_str(), "wb");
+	if (!file)
+	{
+	 std::cerr << "\"" << filename << "\" could not be created!" << std::endl;
+	 return 1;
+	}
+ bool written = (std::fputs("algorithm,frames,position,frame,evicted,page\n", file) >= 0);
+	for (const std::shared_ptr<evictionWriter> &writer : evictions)
+	{written = written && (writer->copyTo(file) == 0);}
+	if (std::fclose(file) != 0 || !written)
+	{
+	 std::cerr << "\"" << filename << "\" could not be written!" << std::endl;
+	 return 1;
+	}
+ return 0;
+}
+
+// This function runs every algorithm on a trace file, without asking anything. It's what "main" does when it's given arguments.
+//================================================================================================================
+int runTraceFile(std::vector<std::shared_ptr<algorithmType>> &algvector, const commandLine &options)
+{
+ int refstrcount;
+ sharedTrace trace;
+ std::string error;
+ std::shared_ptr<pageInterner> interner;
+	if (options.pageshift >= 0)
+	{interner = std::make_shared<pageInterner>((unsigned int)options.pageshift);}
+	if (trace.load(options.tracefile, options.format, refstrcount, error, interner.get()) != 0)
+	{
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ const traceView &refstr = trace.view();
+ std::vector<std::shared_ptr<algorithmType>> chosen;
+	if (choosePolicies(algvector, options.policies, false, chosen) != 0)
+	{return 1;}
+	for (std::shared_ptr<algorithmType> &alg : chosen)
+	{
+	 alg->setSnapshotCapture(options.snapshots || !options.exportfile.empty());
+		if (interner) // the tables (and evictions) show the addresses, not the IDs they were given. Every clone keeps them.
+		{alg->setPageNames(interner);}
+	}
+ std::vector<std::shared_ptr<evictionWriter>> evictions;
+ std::function<std::shared_ptr<algorithmObserver>(algorithmType &)> observe;
+	if (!options.evictionsfile.empty())
+	{
+	 observe = [&evictions](algorithmType &job) -> std::shared_ptr<algorithmObserver>
+	 {
+		evictions.push_back(std::make_shared<evictionWriter>(job));
+		return evictions.back();
+	 };
+	}
+ std::vector<std::shared_ptr<algorithmType>> results = calculateAllAlgorithmsParallel (chosen, options.framesizes, refstrcount, refstr, options.threads,
+                                                                                       nullptr, observe);
+ textBuffer out; // everything goes out at once, at the end.
+	if (!options.evictionsfile.empty() && writeEvictions(options.evictionsfile, evictions) != 0)
+	{return 1;}
+	if (!options.exportfile.empty() && options.exportformat != exportFormat::text)
+	{renderSnapshots(results, options.exportformat, options.threads, out);}
+	else
+	{
+		if (interner)
+		{out << refstrcount << " references to " << interner->size() << " distinct pages of " << (1ull << interner->getShift()) << " bytes\n\n";}
+		for (std::size_t r = 0; r < results.size(); r += chosen.size()) // one group of results for each frame size.
+		{
+		 std::vector<std::shared_ptr<algorithmType>> group(results.begin() + r, results.begin() + r + chosen.size());
+		 out << refstrcount << " references, " << group[0]->getFrameFinalSize() << " frames\n\n";
+		 renderAllAlgorithms (group, out, options.summary, options.threads);
+		 out << (options.summary ? "\n" : "\n\n");
+		}
+	}
+	if (options.exportfile.empty())
+	{return out.writeTo(stdout);}
+ std::FILE *file = std::fopen(options.exportfile.c_str(), "wb");
+	if (!file)
+	{
+	 std::cerr << "\"" << options.exportfile << "\" could not be created!" << std::endl;
+	 return 1;
+	}
+ bool written = (out.writeTo(file) == 0);
+	if (std::fclose(file) != 0 || !written)
+	{
+	 std::cerr << "\"" << options.exportfile << "\" could not be written!" << std::endl;
+	 return 1;
+	}
+ std::cout << results.size() << " runs exported to \"" << options.exportfile << "\" (" << out.size() << " bytes)\n";
+ return 0;
+}
+
+// This function converts a trace file (in any format) to the packed format, and says how much smaller it got. Or to "u32", to be shared.
+//================================================================================================================
+int runPackTrace(const commandLine &options)
+{
+ int refstrcount;
+ sharedTrace trace;
+ std::string error;
+ pageInterner interner((unsigned int)std::max(0, options.pageshift));
+	if (trace.load(options.tracefile, options.format, refstrcount, error, (options.pageshift >= 0 ? &interner : nullptr)) != 0)
+	{
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ const traceView &refstr = trace.view();
+	if (!options.unpackfile.empty())
+	{
+		if (saveUnpackedTraceFile(options.unpackfile, refstr, error) != 0)
+		{
+		 std::cerr << error << std::endl;
+		 return 1;
+		}
+	 std::cout << refstrcount << " references unpacked into " << (std::uint64_t)refstrcount * sizeof(std::uint32_t) << " bytes of u32 page IDs\n";
+		if (options.packfile.empty())
+		{return 0;}
+	}
+ std::uint64_t bytes;
+	if (saveTraceFile(options.packfile, refstr, options.threads, bytes, error) != 0)
+	{
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ std::cout << refstrcount << " references packed into " << bytes << " bytes (" << (double)bytes / refstrcount << " bytes per reference, "
+           << (double)refstrcount * sizeof(std::uint32_t) / bytes << " times smaller than u32)\n";
+ return 0;
+}
+
+// This function runs the chosen algorithms with every number of frames on every trace in "options.sweepfiles", and prints one row
+// per run as soon as each trace is done. The traces are simulated one at a time, with every thread working through that trace's
+// (algorithm, frames) jobs, while the next trace is loaded in the background. So at most 2 traces are ever in memory.
+// Returns 0 if every trace could be loaded and run.
+//================================================================================================================
+int runSweep(std::vector<std::shared_ptr<algorithmType>> &algvector, const commandLine &options)
+{
+ std::vector<std::shared_ptr<algorithmType>> chosen;
+	if (choosePolicies(algvector, options.policies, false, chosen) != 0)
+	{return 1;}
+	for (std::shared_ptr<algorithmType> &alg : chosen)
+	{alg->setSnapshotCapture(false);}
+ struct loadedTrace
+ {
+  int status = 1;
+  int refstrcount = 0;
+  std::unique_ptr<sharedTrace> trace = std::unique_ptr<sharedTrace>(new sharedTrace()); // "next" is moved into "current".
+  std::string error;
+  pageInterner interner; // each trace's addresses are interned on their own, when they are addresses.
+ };
+ unsigned int pageshift = (unsigned int)std::max(0, options.pageshift);
+ loadedTrace current;
+ current.interner = pageInterner(pageshift);
+ current.status = current.trace->load(options.sweepfiles[0], options.format, current.refstrcount, current.error,
+                                     (options.pageshift >= 0 ? &current.interner : nullptr));
+ int failed = 0;
+	if (!options.json)
+	{std::cout << "trace,algorithm,frames,references,page_faults,hits,hit_ratio,seconds\n";}
+	for (std::size_t t = 0; t < options.sweepfiles.size(); t++)
+	{
+	 loadedTrace next;
+	 next.interner = pageInterner(pageshift);
+	 std::thread loader;
+		if (t + 1 < options.sweepfiles.size())
+		{
+		 loader = std::thread([&](){next.status = next.trace->load(options.sweepfiles[t + 1], options.format, next.refstrcount, next.error,
+		                                                          (options.pageshift >= 0 ? &next.interner : nullptr));});
+		}
+		try
+		{
+			if (current.status != 0)
+			{
+			 std::cerr << current.error << std::endl;
+			 failed = 1;
+			}
+			else
+			{
+			 std::vector<double> seconds;
+			 std::vector<std::shared_ptr<algorithmType>> results = calculateAllAlgorithmsParallel (chosen, options.framesizes, current.refstrcount, current.trace->view(), options.threads, &seconds);
+			 std::ostringstream rows;
+				for (std::size_t r = 0; r < results.size(); r++)
+				{
+				 algorithmType &alg = *results[r];
+				 double hitratio = (double)alg.getHit() / current.refstrcount;
+					if (options.json)
+					{
+					 rows << "{\"trace\":" << jsonString(options.sweepfiles[t]) << ",\"algorithm\":" << jsonString(alg.getName())
+					      << ",\"frames\":" << alg.getFrameFinalSize() << ",\"references\":" << current.refstrcount << ",\"page_faults\":" << alg.getMiss()
+					      << ",\"hits\":" << alg.getHit() << ",\"hit_ratio\":" << hitratio << ",\"seconds\":" << seconds[r] << "}\n";
+					}
+					else
+					{
+					 rows << csvField(options.sweepfiles[t]) << "," << csvField(alg.getName()) << "," << alg.getFrameFinalSize() << "," << current.refstrcount
+					      << "," << alg.getMiss() << "," << alg.getHit() << "," << hitratio << "," << seconds[r] << "\n";
+					}
+				}
+			 std::cout << rows.str() << std::flush;
+			}
+		}
+		catch(...) // the loader still has to be joined before anything is unwound.
+		{
+			if (loader.joinable())
+			{loader.join();}
+		 throw;
+		}
+		if (loader.joinable())
+		{loader.join();}
+	 current = std::move(next);
+	}
+ return failed;
+}
+
+// This function reads whatever is waiting on standard input, up to "size" bytes, without waiting for more than that (on a pipe, a read
+// returns as soon as anything arrives). Returns the number of bytes read, 0 at the end of the input, or -1 if it couldn't be read.
+//================================================================================================================
+long readStandardInput(char *buffer, std::size_t size)
+{
+#if defined(_WIN32)
+ // Not "fread", which waits until the whole buffer is filled. Standard input is already in binary mode (see "runStream").
+ return (long)_read(_fileno(stdin), buffer, (unsigned int)std::min(size, (std::size_t)INT_MAX));
+#else
+ ssize_t count;
+	do
+	{count = ::read(0, buffer, size);}
+	while (count < 0 && errno == EINTR);
+ return (long)count;
+#endif
+}
+
+// This function runs the online algorithms on page IDs read from standard input (in "options.format") as they arrive, so the
+// reference string is never stored and its length doesn't matter. Every "options.window" references, and once more at the end,
+// it prints each (algorithm, frames) pair's page faults in that window, and in total, as CSV or JSON lines. A row's "window" is the
+// references that pair decided in it: the lookahead "Opt" decides each one later than it's given, and the rest at the end of the input.
+// Returns 0 if the whole input was read without any problems.
+//================================================================================================================
+int runStream(std::vector<std::shared_ptr<algorithmType>> &algvector, const commandLine &options)
+{
+ std::vector<std::shared_ptr<algorithmType>> chosen;
+	if (choosePolicies(algvector, options.policies, true, chosen) != 0)
+	{return 1;}
+ std::vector<std::shared_ptr<algorithmType>> streams;
+	for (const int &framecount : options.framesizes)
+	{
+		for (const std::shared_ptr<algorithmType> &alg : chosen)
+		{
+		 std::shared_ptr<algorithmType> stream = alg->clone();
+		 stream->setObserver(nullptr);
+		 stream->setSnapshotCapture(false); // a snapshot of every cache line is exactly what a stream can't afford.
+		 stream->setFrameFinalSize(framecount);
+		 stream->startStream();
+		 streams.push_back(stream);
+		}
+	}
+ std::vector<unsigned int> windowstart(streams.size(), 0); // page faults at the start of the window. The counts may wrap around, but the differences don't.
+ std::vector<unsigned long long> totalfaults(streams.size(), 0);
+ std::vector<unsigned long long> totaldecided(streams.size(), 0); // references decided before the window.
+ unsigned long long references = 0;
+ unsigned int inwindow = 0;
+ auto report = [&](bool flush) // with "flush", only the pairs that decided anything since the last window get a row.
+ {
+	std::ostringstream rows;
+	for (std::size_t s = 0; s < streams.size(); s++)
+	{
+	 unsigned int faults = streams[s]->getMiss() - windowstart[s];
+	 unsigned long long decided = references - streams[s]->getUndecided();
+	 unsigned long long windowdecided = decided - totaldecided[s]; // a page fault is only counted when its reference is decided, so it's one of these.
+		if (flush && windowdecided == 0)
+		{continue;}
+	 windowstart[s] = streams[s]->getMiss();
+	 totaldecided[s] = decided;
+	 totalfaults[s] += faults;
+	 double windowrate = (windowdecided > 0 ? (double)faults / windowdecided : 0.0);
+	 double totalrate = (decided > 0 ? (double)totalfaults[s] / decided : 0.0);
+		if (options.json)
+		{
+		 rows << "{\"references\":" << references << ",\"algorithm\":" << jsonString(streams[s]->getName()) << ",\"frames\":" << streams[s]->getFrameFinalSize()
+		      << ",\"window\":" << windowdecided << ",\"window_faults\":" << faults << ",\"window_fault_rate\":" << windowrate
+		      << ",\"total_faults\":" << totalfaults[s] << ",\"total_fault_rate\":" << totalrate << "}\n";
+		}
+		else
+		{
+		 rows << references << "," << csvField(streams[s]->getName()) << "," << streams[s]->getFrameFinalSize() << "," << windowdecided << "," << faults
+		      << "," << windowrate << "," << totalfaults[s] << "," << totalrate << "\n";
+		}
+	}
+	std::cout << rows.str() << std::flush;
+	inwindow = 0;
+ };
+ auto run = [&](const int *pages, std::size_t count) // every stream takes the same pages, one window at a time.
+ {
+	while (count > 0)
+	{
+	 std::size_t part = std::min<std::size_t>(count, (std::size_t)(options.window - inwindow));
+	 parallelFor(streams.size(), (streams.size() > 1 ? options.threads : 1), [&](std::size_t s)
+	 {
+		for (std::size_t i = 0; i < part; i++)
+		{streams[s]->access(pages[i]);}
+	 });
+	 pages += part;
+	 count -= part;
+	 references += part;
+	 inwindow += (unsigned int)part;
+		if (inwindow == (unsigned int)options.window)
+		{report(false);}
+	}
+ };
+	if (!options.json)
+	{std::cout << "references,algorithm,frames,window,window_faults,window_fault_rate,total_faults,total_fault_rate\n";}
+#if defined(_WIN32)
+ _setmode(_fileno(stdin), _O_BINARY);
+#endif
+ std::vector<char> buffer(1 << 16);
+ std::vector<int> pages;
+ pageInterner interner((unsigned int)std::max(0, options.pageshift)); // only used for addresses. It grows with every new page.
+ bool interning = (options.pageshift >= 0);
+ std::size_t kept = 0; // bytes of a number or page ID that were cut off at the end of the last read.
+ bool ended = false;
+	while (!ended)
+	{
+	 long count = readStandardInput(buffer.data() + kept, buffer.size() - kept);
+		if (count < 0)
+		{
+		 std::cerr << "Standard input could not be read!" << std::endl;
+		 return 2;
+		}
+	 ended = (count == 0);
+	 const char *p = buffer.data();
+	 const char *end = p + kept + count;
+	 pages.clear();
+		if (options.format == traceFormat::text)
+		{
+		 int numint;
+		 std::uint64_t address;
+			while (p < end)
+			{
+				if (std::isspace((unsigned char)*p) || *p == ',')
+				{
+				 p++;
+				 continue;
+				}
+			 const char *token = p;
+				while (p < end && !std::isspace((unsigned char)*p) && *p != ',') {p++;}
+				if (p == end && !ended) // it may not be finished yet.
+				{
+				 p = token;
+				 break;
+				}
+			 const char *digits = token;
+				if (interning ? parseAddress(digits, p, address) != 0 : parseInt(digits, p, numint) != 0)
+				{
+				 std::cerr << "\"" << std::string(token, p) << (interning ? "\" is not a 64 bit address!" : "\" is not an integer in the range of an 'int'!") << std::endl;
+				 return 2;
+				}
+				if (interning && (numint = interner.intern(address)) < 0)
+				{
+				 std::cerr << "There are more distinct pages than can be counted in an 'int'!" << std::endl;
+				 return 2;
+				}
+			 pages.push_back(numint);
+			}
+		}
+		else
+		{
+		 std::size_t width = (options.format == traceFormat::u32 ? sizeof(std::uint32_t) : sizeof(std::uint64_t));
+			for (; end - p >= (std::ptrdiff_t)width; p += width)
+			{
+				if (interning)
+				{
+				 std::uint64_t address = 0;
+					if (options.format == traceFormat::u32)
+					{
+					 std::uint32_t numint;
+					 std::memcpy(&numint, p, width);
+					 address = numint;
+					}
+					else
+					{std::memcpy(&address, p, width);}
+				 int id = interner.intern(address);
+					if (id < 0)
+					{
+					 std::cerr << "There are more distinct pages than can be counted in an 'int'!" << std::endl;
+					 return 2;
+					}
+				 pages.push_back(id);
+				}
+				else if (options.format == traceFormat::u32)
+				{
+				 std::uint32_t numint;
+				 std::memcpy(&numint, p, width);
+				 pages.push_back((int)numint); // page IDs are kept bit for bit.
+				}
+				else
+				{
+				 std::uint64_t numint;
+				 std::memcpy(&numint, p, width);
+					if (numint > UINT32_MAX)
+					{
+					 std::cerr << "page ID " << numint << " does not fit in 32 bits! (Addresses can be read with --page-size.)" << std::endl;
+					 return 2;
+					}
+				 pages.push_back((int)(std::uint32_t)numint);
+				}
+			}
+			if (ended && p < end)
+			{
+			 std::cerr << "The input is not a whole number of " << width * 8 << " bit page IDs!" << std::endl;
+			 return 2;
+			}
+		}
+	 kept = (std::size_t)(end - p);
+		if (kept == buffer.size()) // one "number" filled the whole buffer.
+		{
+		 std::cerr << "\"" << std::string(p, p + 20) << "...\" is not " << (interning ? "a 64 bit address!" : "an integer in the range of an 'int'!") << std::endl;
+		 return 2;
+		}
+	 std::memmove(buffer.data(), p, kept);
+	 run(pages.data(), pages.size());
+	}
+	for (std::shared_ptr<algorithmType> &stream : streams) // anything that decides late (the lookahead "Opt") catches up.
+	{stream->finishStream();}
+ report(true); // the last (partial) window, and the references that were only decided now.
+ return 0;
+}
+
+// A trace where every reference is tagged with the process (tenant) that made it. Tenants and pages both get dense IDs: tenant 0 is
+// the first process seen, and so on, and every (process, page) pair is a page of its own, so the same page number in two processes
+// is two different pages. Everything is in flat arrays, indexed by reference, page or tenant.
+struct taggedTrace
+{
+ int refstrcount = 0;
+ std::vector<int> refstr; // the page of each reference.
+ std::vector<int> tenant; // the tenant of each reference.
+ std::vector<int> owner; // the tenant of each page.
+ std::vector<int> pids; // the process I.D. of each tenant.
+ std::vector<int> distinct; // how many different pages each tenant used.
+};
+
+// This function loads a tagged trace: pairs of a process I.D. and a page, as text ("pid page" or "pid,page"), or as pairs of u32
+// or u64 values. With a "pageshift" of 0 or more, the pages are addresses, interned like "--page-size" does for any other trace.
+// Returns 0 if there were no problems. Otherwise "error" describes what went wrong.
+//================================================================================================================
+int loadTaggedTrace(const std::string &path, traceFormat format, int pageshift, taggedTrace &trace, std::string &error)
+{
+ trace = taggedTrace();
+ mappedFile file;
+	if (file.open(path) != 0)
+	{
+	 error = "\"" + path + "\" could not be opened!";
+	 return 1;
+	}
+	if (format == traceFormat::packed)
+	{
+	 error = "A tagged trace can't be packed. Use \"text\", \"u32\" or \"u64\".";
+	 return 2;
+	}
+ pageInterner tenants; // process I.D. -> tenant.
+ pageInterner addresses((unsigned int)std::max(0, pageshift)); // address -> page, with "--page-size".
+ pageInterner pages; // (tenant, page) -> page.
+ auto add = [&](int pid, std::uint64_t page) -> int // returns 0, or 1 if there are too many pages.
+ {
+	int t = tenants.intern((std::uint32_t)pid);
+	if (t == (int)trace.pids.size())
+	{
+	 trace.pids.push_back(pid);
+	 trace.distinct.push_back(0);
+	}
+	if (pageshift >= 0)
+	{
+	 int id = addresses.intern(page);
+		if (id < 0)
+		{return 1;}
+	 page = (std::uint32_t)id;
+	}
+	int p = pages.intern(((std::uint64_t)(std::uint32_t)t << 32) | (std::uint32_t)page);
+	if (p < 0 || trace.refstr.size() >= (std::size_t)INT_MAX)
+	{return 1;}
+	if (p == (int)trace.owner.size())
+	{
+	 trace.owner.push_back(t);
+	 trace.distinct[t]++;
+	}
+	trace.refstr.push_back(p);
+	trace.tenant.push_back(t);
+	return 0;
+ };
+ const char *p = file.data();
+ const char *end = p + file.size();
+	if (format == traceFormat::text)
+	{
+	 int pid, numint;
+	 std::uint64_t address;
+	 bool haspid = false;
+		while (p < end)
+		{
+			if (std::isspace((unsigned char)*p) || *p == ',')
+			{
+			 p++;
+			 continue;
+			}
+		 const char *token = p;
+		 int status = (!haspid ? parseInt(p, end, pid) : pageshift >= 0 ? parseAddress(p, end, address) : parseInt(p, end, numint));
+			if (status != 0)
+			{
+			 while (p < end && !std::isspace((unsigned char)*p) && *p != ',') {p++;}
+			 error = "\"" + std::string(token, p) + (haspid && pageshift >= 0 ? "\" is not a 64 bit address!" : "\" is not an integer in the range of an 'int'!");
+			 return 2;
+			}
+			if (haspid && add(pid, (pageshift >= 0 ? address : (std::uint32_t)numint)) != 0)
+			{
+			 error = "\"" + path + "\" has more references or pages than can be counted in an 'int'!";
+			 return 2;
+			}
+		 haspid = !haspid;
+		}
+		if (haspid)
+		{
+		 error = "\"" + path + "\" ends with a process I.D. without a page!";
+		 return 2;
+		}
+	}
+	else
+	{
+	 std::size_t width = (format == traceFormat::u32 ? sizeof(std::uint32_t) : sizeof(std::uint64_t));
+		if (file.size() % (2 * width) != 0)
+		{
+		 error = "\"" + path + "\" is not a whole number of pairs of " + std::to_string(width * 8) + " bit values!";
+		 return 2;
+		}
+		for (; p < end; p += 2 * width)
+		{
+		 std::uint64_t pid = 0, page = 0;
+			if (format == traceFormat::u32)
+			{
+			 std::uint32_t numint;
+			 std::memcpy(&numint, p, width);
+			 pid = numint;
+			 std::memcpy(&numint, p + width, width);
+			 page = numint;
+			}
+			else
+			{
+			 std::memcpy(&pid, p, width);
+			 std::memcpy(&page, p + width, width);
+				if (pid > UINT32_MAX || (pageshift < 0 && page > UINT32_MAX))
+				{
+				 error = "\"" + path + "\" has a process I.D. or page that does not fit in 32 bits! (Addresses can be read with --page-size.)";
+				 return 2;
+				}
+			}
+			if (add((int)(std::uint32_t)pid, page) != 0)
+			{
+			 error = "\"" + path + "\" has more references or pages than can be counted in an 'int'!";
+			 return 2;
+			}
+		}
+	}
+ trace.refstrcount = (int)trace.refstr.size();
+	if (trace.refstrcount < 1)
+	{
+	 error = "\"" + path + "\" has no references in it!";
+	 return 2;
+	}
+ return 0;
+}
+
+// What each tenant got out of one simulation of a tagged trace.
+struct tenantResults
 {
-	// Range based "for" loop that loops through each object of type "algorithmType" and resets everything for each new loop in "main".
-	for (std::shared_ptr<algorithmType> &alg : algvector)
+ std::vector<unsigned long long> faults;
+ std::vector<unsigned long long> stolen; // pages taken away by another tenant's page fault.
+ std::vector<unsigned long long> pressure; // page faults that needed a frame the tenant didn't have to spare (see "runTenants").
+ std::vector<double> meanframes; // frames held, on average, over the whole trace.
+
+ void reset(std::size_t tenants)
+ {
+  faults.assign(tenants, 0);
+  stolen.assign(tenants, 0);
+  pressure.assign(tenants, 0);
+  meanframes.assign(tenants, 0.0);
+ }
+};
+
+// This is a HELPER class that keeps track of how many frames each tenant holds, and how many it held on average.
+// Only the tenant whose count changes is touched, so it costs the same with any number of tenants.
+class tenantFrames
+{
+ public:
+	void reset(std::size_t tenants)
 	{
-	 alg->clearAlg();
-	 alg->setRow(0);
-	 alg->setMiss(0);
+	 held.assign(tenants, 0);
+	 area.assign(tenants, 0.0);
+	 changed.assign(tenants, 0);
 	}
-}
 
-// Function that uses a range based "for" loop to calculate every algorithm that was added to the vector "algvector".
-//================================================================================================================
-void calculateAllAlgorithms (std::vector<std::shared_ptr<algorithmType>> &algvector, const int &refstrcount, const std::vector<int> &refstr)
+	void change(int t, long long position, int delta)
+	{
+	 area[t] += (double)held[t] * (double)(position - changed[t]);
+	 changed[t] = position;
+	 held[t] += delta;
+	}
+
+	unsigned int count(int t) const
+	{return held[t];}
+
+	void finish(long long position, std::vector<double> &meanframes)
+	{
+		for (std::size_t t = 0; t < held.size(); t++)
+		{
+		 change((int)t, position, 0);
+		 meanframes[t] = area[t] / (double)position;
+		}
+	}
+
+ private:
+	std::vector<unsigned int> held;
+	std::vector<double> area; // frames held, summed over every reference so far.
+	std::vector<long long> changed;
+};
+
+// This observer splits a shared pool's page faults and evictions by tenant, for global replacement: any algorithm runs on every
+// tenant's pages at once, and doesn't know there are tenants at all.
+class tenantObserver : public algorithmObserver
 {
-	for (std::shared_ptr<algorithmType> &alg : algvector)
-	{alg->calculateAlgorithm(refstrcount, refstr);}
-}
+ public:
+	tenantObserver(const taggedTrace &ptrace) : trace(ptrace)
+	{
+	 results.reset(trace.pids.size());
+	 frames.reset(trace.pids.size());
+	}
 
-// Function that uses a range based "for" loop to display every algorithm that was added to the vector "algvector".
-//================================================================================================================
-void displayAllAlgorithms (std::vector<std::shared_ptr<algorithmType>> &algvector)
+	virtual void onMiss(const algorithmType &, int position, int page) override
+	{
+	 int t = trace.tenant[position];
+	 results.faults[t]++;
+	 frames.change(trace.owner[page], position, 1);
+	}
+
+	virtual void onEvict(const algorithmType &, int position, unsigned int /*frame*/, int evicted, int /*page*/) override
+	{
+	 int t = trace.tenant[position], u = trace.owner[evicted];
+		if (u != t)
+		{
+		 results.stolen[u]++;
+		 results.pressure[t]++;
+		}
+	 frames.change(u, position, -1);
+	}
+
+	const tenantResults &finish()
+	{
+	 frames.finish(trace.refstrcount, results.meanframes);
+	 return results;
+	}
+
+ private:
+	const taggedTrace &trace;
+	tenantResults results;
+	tenantFrames frames;
+};
+
+// The allocators for local replacement (see "localReplacement").
+enum class tenantAllocator {equal, workingset, pff};
+
+// This is a HELPER class that simulates local replacement: a tenant only ever replaces its own pages, in LRU order, and the
+// allocator decides how many frames each tenant gets:
+//	"equal": every tenant gets the same share of the frames, for good.
+//	"workingset": a tenant keeps the pages it used in its last "window" references (its working set), and gives the rest back.
+//	"pff": page fault frequency. A tenant that faults again within "interval" of its own references takes one more frame, and one
+//	       that went longer than that gives back every page it hasn't used since its last page fault (and replaces its own LRU page).
+// Frames that are given back go to a free pool. A tenant that wants another frame when none are free replaces its own LRU page; that's
+// "pressure" if it's below its equal share. A tenant without any frames at all takes one from the others, round robin.
+// Every tenant's pages are in one intrusive LRU list, and every list lives in the same flat arrays, indexed by page.
+class localReplacement
 {
-	for (std::vector<std::shared_ptr<algorithmType>>::iterator itr_pos = algvector.begin(); itr_pos != algvector.end(); ++itr_pos)
+ public:
+	void run(const taggedTrace &trace, unsigned int framecount, tenantAllocator allocator, int window, int interval, tenantResults &results)
 	{
-	 (*itr_pos)->displayAlgorithm();
-		if (std::next(itr_pos, 1) != algvector.end()) // Do not automatically put a space after the last algorithm output.
+	 std::size_t tenants = trace.pids.size();
+	 std::size_t pagecount = trace.owner.size();
+	 prev.assign(pagecount, none);
+	 next.assign(pagecount, none);
+	 lastuse.assign(pagecount, 0);
+	 resident.assign(pagecount, 0);
+	 lru.assign(tenants, none);
+	 mru.assign(tenants, none);
+	 share.resize(tenants);
+		for (std::size_t t = 0; t < tenants; t++)
+		{share[t] = (unsigned int)(framecount / tenants + (t < framecount % tenants ? 1 : 0));}
+	 quota.assign(tenants, framecount); // the most frames a tenant can grow to.
+		if (allocator == tenantAllocator::equal)
+		{quota = share;}
+	 vtime.assign(tenants, 0);
+	 lastfault.assign(tenants, 0);
+	 frames.reset(tenants);
+	 results.reset(tenants);
+	 unsigned int freeframes = framecount;
+	 std::size_t hand = 0;
+		for (int i = 0; i < trace.refstrcount; i++)
 		{
-		 std::cout << "\n\n"; // Space in between each algorithm output.
+		 int t = trace.tenant[i];
+		 int page = trace.refstr[i];
+		 long long now = ++vtime[t]; // each tenant's own (virtual) time.
+			if (allocator == tenantAllocator::workingset) // pages that left the working set give their frames back.
+			{
+				while (lru[t] != none && lastuse[lru[t]] + window <= now)
+				{
+				 evict(t, i);
+				 freeframes++;
+				}
+			}
+			if (resident[page])
+			{
+			 unlink(t, page);
+			 append(t, page);
+			 lastuse[page] = now;
+			 continue;
+			}
+		 results.faults[t]++;
+		 bool faultedsoon = true;
+			if (allocator == tenantAllocator::pff)
+			{
+			 faultedsoon = (lastfault[t] > 0 && now - lastfault[t] <= interval);
+				if (lastfault[t] > 0 && now - lastfault[t] > interval) // faulting slowly, so give back what wasn't used since the last fault.
+				{
+					while (lru[t] != none && lastuse[lru[t]] < lastfault[t])
+					{
+					 evict(t, i);
+					 freeframes++;
+					}
+				}
+			 lastfault[t] = now;
+			}
+		 bool wantsmore = (frames.count(t) < quota[t] && (faultedsoon || frames.count(t) == 0)); // pff only grows when faulting often.
+			if (wantsmore && freeframes > 0)
+			{freeframes--;}
+			else if (frames.count(t) > 0)
+			{
+				if (wantsmore && frames.count(t) < share[t])
+				{results.pressure[t]++;}
+			 evict(t, i);
+			}
+			else // nothing free, and nothing of its own to replace.
+			{
+			 results.pressure[t]++;
+				while ((int)hand == t || frames.count((int)hand) == 0)
+				{hand = (hand + 1) % tenants;}
+			 results.stolen[hand]++;
+			 evict((int)hand, i);
+			 hand = (hand + 1) % tenants;
+			}
+		 resident[page] = 1;
+		 lastuse[page] = now;
+		 append(t, page);
+		 frames.change(t, i, 1);
 		}
+	 frames.finish(trace.refstrcount, results.meanframes);
 	}
-}
 
-// This function is used by function "getInput" to prevent incorrect input from the user from crashing program.
+ private:
+	static const unsigned int none = 0xFFFFFFFFu;
+
+	void append(int t, int page) // as the most recently used page of tenant "t".
+	{
+	 prev[page] = mru[t];
+	 next[page] = none;
+		if (mru[t] != none)
+		{next[mru[t]] = (unsigned int)page;}
+		else
+		{lru[t] = (unsigned int)page;}
+	 mru[t] = (unsigned int)page;
+	}
+
+	void unlink(int t, int page)
+	{
+		if (prev[page] != none)
+		{next[prev[page]] = next[page];}
+		else
+		{lru[t] = next[page];}
+		if (next[page] != none)
+		{prev[next[page]] = prev[page];}
+		else
+		{mru[t] = prev[page];}
+	}
+
+	void evict(int t, int position) // the least recently used page of tenant "t".
+	{
+	 unsigned int page = lru[t];
+	 unlink(t, (int)page);
+	 resident[page] = 0;
+	 frames.change(t, position, -1);
+	}
+
+	std::vector<unsigned int> prev, next; // per page.
+	std::vector<long long> lastuse;
+	std::vector<unsigned char> resident;
+	std::vector<unsigned int> lru, mru, share, quota; // per tenant.
+	std::vector<long long> vtime, lastfault;
+	tenantFrames frames;
+};
+
+const unsigned int localReplacement :: none; // same as "LookaheadOpt :: never".
+
+// This function simulates a tagged trace ("options.tenantfile") with every number of frames, shared by every tenant, under global
+// replacement (with each chosen policy, over the whole pool) and under local replacement (LRU within each tenant, with each allocator).
+// It prints one row per tenant for each: its page faults, the faults that weren't its first use of a page, the frames it held on
+// average, the pages other tenants took from it ("stolen"), and its "pressure": the faults that took a page from another tenant
+// (global), or that wanted another frame when none were free while below its equal share (local). A tenant is marked as thrashing
+// when more than half of its references were page faults that weren't its first use of a page. Every (scheme, frames) run is a job
+// of its own, on as many threads as allowed.
+// Returns 0 if the trace could be loaded.
 //================================================================================================================
-int strToInt(const std::string &str, int &i)
+int runTenants(std::vector<std::shared_ptr<algorithmType>> &algvector, const commandLine &options)
 {
- int r_error = 0;
-	try
+ std::vector<std::shared_ptr<algorithmType>> chosen;
+	if (choosePolicies(algvector, options.policies, false, chosen) != 0)
+	{return 1;}
+ taggedTrace trace;
+ std::string error;
+	if (loadTaggedTrace(options.tenantfile, options.format, options.pageshift, trace, error) != 0)
 	{
-	 i = (int)std::trunc(stod(str)); // here is where you can change how to handle decimal numbers.
-	                     // I elected to truncate any non integer type variables behind the scenes, without throwing an exception.
-						 // Note, if you use 'stoi' instead, it will implicitly truncate any non integer type variable anyway.
+	 std::cerr << error << std::endl;
+	 return 1;
 	}
-     catch(std::invalid_argument&)
+ std::vector<unsigned long long> references(trace.pids.size(), 0);
+	for (const int &t : trace.tenant)
+	{references[t]++;}
+ const tenantAllocator allocators[3] = {tenantAllocator::equal, tenantAllocator::workingset, tenantAllocator::pff};
+ const char *schemes[3] = {"local-equal", "local-ws", "local-pff"};
+ std::size_t perframes = chosen.size() + 3;
+ std::vector<int> framesizes = clampFrameList(options.framesizes, trace.refstrcount);
+ std::vector<std::string> rows(framesizes.size() * perframes);
+ parallelFor(rows.size(), options.threads, [&](std::size_t j)
+ {
+	unsigned int framecount = (unsigned int)framesizes[j / perframes];
+	std::size_t s = j % perframes;
+	tenantResults results;
+	std::string scheme, policy;
+	if (s < chosen.size())
 	{
-     // if no conversion could be performed
-	 r_error = 1;
-    }
-    catch(std::out_of_range&)
+	 std::shared_ptr<tenantObserver> observer = std::make_shared<tenantObserver>(trace);
+	 std::shared_ptr<algorithmType> alg = chosen[s]->clone();
+	 alg->setSnapshotCapture(false);
+	 alg->setObserver(observer);
+	 alg->setFrameFinalSize(framecount);
+	 alg->measureAlgorithm(trace.refstrcount, trace.refstr);
+	 results = observer->finish();
+	 scheme = "global";
+	 policy = alg->getName();
+	}
+	else
 	{
-     // if the converted value would fall out of the range of the result type 
-     // or if the underlying function (std::strtol or std::strtoull) sets errno 
-     // to ERANGE.
-	 r_error = 2;
-    }
-    catch(...)
+	 localReplacement local;
+	 local.run(trace, framecount, allocators[s - chosen.size()], options.wswindow, options.pffinterval, results);
+	 scheme = schemes[s - chosen.size()];
+	 policy = "LRU";
+	}
+	std::ostringstream out;
+	for (std::size_t t = 0; t < trace.pids.size(); t++)
 	{
-     // everything else
-	 r_error = 3;
-    }
+	 unsigned long long repeated = results.faults[t] - std::min<unsigned long long>(results.faults[t], trace.distinct[t]); // not a first use.
+	 double faultrate = (double)results.faults[t] / references[t];
+	 bool thrashing = (2 * repeated > references[t]);
+		if (options.json)
+		{
+		 out << "{\"scheme\":\"" << scheme << "\",\"policy\":" << jsonString(policy) << ",\"frames\":" << framecount << ",\"tenant\":" << t
+		     << ",\"pid\":" << trace.pids[t] << ",\"references\":" << references[t] << ",\"page_faults\":" << results.faults[t]
+		     << ",\"fault_rate\":" << faultrate << ",\"repeat_faults\":" << repeated << ",\"mean_frames\":" << results.meanframes[t]
+		     << ",\"stolen\":" << results.stolen[t] << ",\"pressure\":" << results.pressure[t] << ",\"thrashing\":" << (thrashing ? "true" : "false") << "}\n";
+		}
+		else
+		{
+		 out << scheme << "," << csvField(policy) << "," << framecount << "," << t << "," << trace.pids[t] << "," << references[t] << ","
+		     << results.faults[t] << "," << faultrate << "," << repeated << "," << results.meanframes[t] << "," << results.stolen[t] << ","
+		     << results.pressure[t] << "," << (thrashing ? 1 : 0) << "\n";
+		}
+	}
+	rows[j] = out.str();
+ });
+	if (!options.json)
+	{std::cout << "scheme,policy,frames,tenant,pid,references,page_faults,fault_rate,repeat_faults,mean_frames,stolen,pressure,thrashing\n";}
+	for (const std::string &row : rows)
+	{std::cout << row;}
+ std::cout << std::flush;
+ return 0;
+}
 
- return r_error;
+// This function prints the number of page faults LRU and OPT would have with every number of frames from 1 to "options.mrcframes",
+// as CSV, from a single pass over the trace for each, instead of running both algorithms once per number of frames.
+//================================================================================================================
+int runMissRatioCurve(const commandLine &options)
+{
+ int refstrcount;
+ sharedTrace trace;
+ std::string error;
+ pageInterner interner((unsigned int)std::max(0, options.pageshift));
+	if (trace.load(options.tracefile, options.format, refstrcount, error, (options.pageshift >= 0 ? &interner : nullptr)) != 0)
+	{
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ const traceView &refstr = trace.view();
+ stackDistanceHistogram lruhistogram, opthistogram;
+ lruhistogram.reset(options.mrcframes);
+ opthistogram.reset(options.mrcframes);
+ std::thread optthread(optStackDistances, std::cref(refstrcount), std::cref(refstr), std::ref(opthistogram)); // both only read the reference string.
+ lruStackDistances(refstrcount, refstr, lruhistogram);
+ optthread.join();
+ std::vector<unsigned long long> lrufaults = lruhistogram.getFaultCurve();
+ std::vector<unsigned long long> optfaults = opthistogram.getFaultCurve();
+ std::cout << "frames,lru_faults,lru_miss_ratio,opt_faults,opt_miss_ratio\n";
+	for (int c = 1; c <= options.mrcframes; c++)
+	{
+	 std::cout << c << "," << lrufaults[c] << "," << (double)lrufaults[c] / refstrcount << ","
+	           << optfaults[c] << "," << (double)optfaults[c] / refstrcount << "\n";
+	}
+ return 0;
 }
 
-// This function gets the input from the user, which is the reference string and how many rows (frames) it should be.
+// This function prints the estimated (SHARDS) LRU and OPT miss ratios for every number of frames from 1 to "options.mrcframes", as CSV.
+// With "--shards-budget", only LRU is estimated, since OPT can't be sampled down to a fixed number of pages without knowing the future.
+// With "--shards-exact", the exact curves are calculated too, and the error of each estimate is printed after the table.
 //================================================================================================================
-int getInput(int &refstrcount, std::vector<int> &refstr, const int &maxrefstrsize, const int &maxframesize)
+int runSampledMissRatioCurve(const commandLine &options)
 {
- refstr.clear(); // this reference string is being cleared from the last inputted values, to accept the new reference string.
- std::vector<int>().swap(refstr); // also shrink down the capacity of vector for each new request, so it doesn't cause any memory problems.
- std::string line, selectionnumber;
- int numint, randnum, errorcount;
- refstrcount = 0; // initialization.
- 
- numint = 0;
- std::cout << "Would you like to generate a random reference string (1) or to enter a reference string (2)?\n";
-	while (numint != 1 && numint != 2)
+ int refstrcount;
+ sharedTrace trace;
+ std::string error;
+ pageInterner interner((unsigned int)std::max(0, options.pageshift));
+	if (trace.load(options.tracefile, options.format, refstrcount, error, (options.pageshift >= 0 ? &interner : nullptr)) != 0)
 	{
-	 cin_custom(selectionnumber);
-		if (strToInt(selectionnumber, numint) != 0)
-		{std::cout << "This is not a valid input. Please select either \"1\" or \"2\":\n";}
-		else 
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ const traceView &refstr = trace.view();
+ double rate = (options.shardsrate > 0.0 ? options.shardsrate : 1.0);
+ bool withopt = (options.shardsbudget == 0);
+ shardsSampler sampler;
+ sampler.reset(rate, options.shardsbudget, options.mrcframes);
+	for (int i = 0; i < refstrcount; i++)
+	{sampler.access(refstr[i]);}
+ std::vector<double> lrucurve = sampler.getMissRatioCurve();
+ std::vector<double> optcurve;
+	if (withopt)
+	{optcurve = shardsOptMissRatioCurve(refstrcount, refstr, rate, options.mrcframes);}
+ std::vector<unsigned long long> lruexact, optexact;
+	if (options.shardsexact)
+	{
+	 stackDistanceHistogram lruhistogram, opthistogram;
+	 lruhistogram.reset(options.mrcframes);
+	 lruStackDistances(refstrcount, refstr, lruhistogram);
+	 lruexact = lruhistogram.getFaultCurve();
+		if (withopt)
 		{
-			if (numint != 1 && numint != 2)
-			{std::cout << "The number you selected was not \"1\" or \"2\". Please try again:\n";}
+		 opthistogram.reset(options.mrcframes);
+		 optStackDistances(refstrcount, refstr, opthistogram);
+		 optexact = opthistogram.getFaultCurve();
 		}
 	}
-	
- std::cout << std::endl;
-	
-	if (numint == 1)
+ std::cout << "frames,lru_miss_ratio" << (withopt ? ",opt_miss_ratio" : "") << (options.shardsexact ? ",lru_exact" : "") << (options.shardsexact && withopt ? ",opt_exact" : "") << "\n";
+ double lrumax = 0.0, lrusum = 0.0, optmax = 0.0, optsum = 0.0;
+	for (int c = 1; c <= options.mrcframes; c++)
 	{
-	 numint = 0;
-	 std::cout << "Please enter the number of reference string elements (between 1 and " << maxrefstrsize << ")\n";
-		while (numint < 1 || numint > maxrefstrsize)
+	 std::cout << c << "," << lrucurve[c];
+		if (withopt)
+		{std::cout << "," << optcurve[c];}
+		if (options.shardsexact)
 		{
-		 cin_custom(selectionnumber);
-			if (strToInt(selectionnumber, numint) != 0)
-			{std::cout << "This is not a valid input. Please select number between \"1\" and \"" << maxrefstrsize << "\":\n";}
-			else
+		 double lruratio = (double)lruexact[c] / refstrcount;
+		 lrumax = std::max(lrumax, std::fabs(lrucurve[c] - lruratio));
+		 lrusum += std::fabs(lrucurve[c] - lruratio);
+		 std::cout << "," << lruratio;
+			if (withopt)
 			{
-				if (numint < 1 || numint > maxrefstrsize)
-				{std::cout << "The number you selected was not between \"1\" and \"" << maxrefstrsize << "\". Please try again:\n";}
+			 double optratio = (double)optexact[c] / refstrcount;
+			 optmax = std::max(optmax, std::fabs(optcurve[c] - optratio));
+			 optsum += std::fabs(optcurve[c] - optratio);
+			 std::cout << "," << optratio;
 			}
 		}
-	 refstrcount = numint;
-	 std::srand((unsigned int)std::time(NULL));
-	 std::cout << std::endl;
-		for (int i = 0; i < refstrcount; i++)
+	 std::cout << "\n";
+	}
+ std::cout << "# sampling rate " << sampler.getRate() << ", " << sampler.getSampledReferences() << " of " << refstrcount
+           << " references sampled, " << sampler.getTrackedPages() << " pages tracked\n";
+	if (options.shardsexact)
+	{
+	 std::cout << "# lru mean absolute error " << lrusum / options.mrcframes << ", max absolute error " << lrumax << "\n";
+		if (withopt)
+		{std::cout << "# opt mean absolute error " << optsum / options.mrcframes << ", max absolute error " << optmax << "\n";}
+		if (options.shardsbudget == 0 && sampler.getRate() >= 1.0 && lrumax > 1e-12) // every reference was sampled, so nothing was estimated.
 		{
-		 randnum = std::rand() % 10;
-		 refstr.push_back(randnum);
-		 std::cout << refstr[i];
-			if((i + 1) < refstrcount)
-			{std::cout << " ";}
+		 std::cerr << "With every page sampled, the LRU curve should be exact, but it's off by up to " << lrumax << "!\n";
+		 return 1;
 		}
-	 std::cout << std::endl;
 	}
-	
-	else // numint = 2
+ return 0;
+}
+
+// This function profiles a trace in one pass, to help choose the numbers of frames to run it with, and prints what it found as CSV
+// with one value per row ("metric,window,key,value"), so everything can go into one file:
+//	"reuse_distance": how many references had a reuse distance in each bucket of powers of 2 ("key" is the smallest distance in the
+//	                  bucket, or "inf" for the first use of a page). A reuse distance is the LRU stack distance: the number of
+//	                  different pages used since the last use of the same page, counting itself, so it's the fewest frames LRU
+//	                  would need for that reference to be a hit.
+//	"working_set": W(t, window), the number of different pages in the last "window" references up to reference 't' ("key"), for
+//	               about 100 values of 't' for each window. "working_set_mean" is its average over every 't'.
+//	"frequency": how many times each page was used, most used first ("key" is the page, or its address with "--page-size").
+// Like "lruStackDistances", only the last use of each page is marked in a Fenwick tree, so both a reuse distance and a W(t, window)
+// are the number of marks in a range: O(log n) each, for O(n log n) in all.
+//================================================================================================================
+int runProfile(const commandLine &options)
+{
+ int refstrcount;
+ sharedTrace trace;
+ std::string error;
+ pageInterner interner((unsigned int)std::max(0, options.pageshift));
+	if (trace.load(options.tracefile, options.format, refstrcount, error, (options.pageshift >= 0 ? &interner : nullptr)) != 0)
 	{
-	 errorcount = 1; // Temporarily set to one so while loop works, without the need of a do-while loop.
-		while (errorcount)
+	 std::cerr << error << std::endl;
+	 return 1;
+	}
+ const traceView &refstr = trace.view();
+ struct pageUses
+ {
+  int last; // position of the last use.
+  unsigned long long uses;
+ };
+ std::unordered_map<int, pageUses> pages;
+ fenwickTree marks;
+ marks.reset(refstrcount);
+ std::vector<unsigned long long> reuse(32, 0); // bucket 'b' counts the distances from 2^b to 2^(b+1) - 1.
+ unsigned long long firstuses = 0;
+ const std::vector<int> &windows = options.profilewindows;
+ std::vector<double> worksetsum(windows.size(), 0.0);
+ std::vector<std::string> worksets(windows.size());
+ int step = std::max(1, refstrcount / 100);
+	for (int i = 0; i < refstrcount; i++)
+	{
+	 std::unordered_map<int, pageUses>::iterator itr_page = pages.find(refstr[i]);
+		if (itr_page == pages.end())
 		{
-		 refstr.clear(); // this reference string is being cleared from the last inputted values, to accept the new reference string.
-		 std::vector<int>().swap(refstr); // also shrink down the capacity of vector for each new request, so it doesn't cause any memory problems.
-		 refstrcount = 0;
-		 errorcount = 0; // Now that we're inside the while loop, we start with zero errors.
-		 std::string num;
-		 std::cout << "Enter numbers separated by spaces:\n\n";
-		 getline(std::cin, line);
-		 remove_extra_whitespaces(line);
-		 trim(line);
-		 std::stringstream  lineStream(line);
-			while (getline(lineStream, num, ' ')) // the 'space' is the delimiter
-			{
-				if (strToInt(num, numint) != 0)
-				{
-				 errorcount++;
-				 std::cout << "\"" << num << "\"" << " is not an integer!\n";
-				}
-				else
-				{
-					if (num.size() > 4) // Number is most likely too big to fit in an 'int'.
-				    {
-					 errorcount++;
-					 std::cout << "\"" << num << "\"" << " is too big!\n";
-				    }
-					else
-					{
-					    if (numint >= 0 && numint <= 9)
-					    {
-						 refstr.push_back(numint); // place next number on the back of the stack, which will be used in alogoithm calculations.
-						 refstrcount++;
-					    }
-					    else
-					    {
-						 errorcount++;
-						 std::cout << "\"" << numint << "\"" << " is out of range! Number must be between 0-9.\n";
-					    }
-					}
-				}
-			}
-			if (refstrcount < 1 || refstrcount > maxrefstrsize)
-			{
-			 errorcount++;
-			 std::cout << "The amount of reference strings you entered was not between \"1\" and \"" << maxrefstrsize << "\". Please try again:\n";
-			}
-			if (errorcount)
-			{std::cout << "There were " << errorcount << " errors! Please try again!\n";}
+		 firstuses++;
+		 pages.emplace(refstr[i], pageUses{i, 1});
+		}
+		else
+		{
+		 unsigned long long distance = (unsigned long long)(marks.prefix(i) - marks.prefix(itr_page->second.last));
+		 unsigned int b = 0;
+			while ((2ull << b) <= distance)
+			{b++;}
+		 reuse[b]++;
+		 marks.add(itr_page->second.last, -1);
+		 itr_page->second.last = i;
+		 itr_page->second.uses++;
+		}
+	 marks.add(i, 1);
+	 long long upto = marks.prefix(i + 1);
+		for (std::size_t w = 0; w < windows.size(); w++)
+		{
+		 long long workset = upto - marks.prefix(std::max(0, i + 1 - windows[w]));
+		 worksetsum[w] += (double)workset;
+			if ((i + 1) % step == 0 || i + 1 == refstrcount)
+			{worksets[w] += "working_set," + std::to_string(windows[w]) + "," + std::to_string(i + 1) + "," + std::to_string(workset) + "\n";}
 		}
 	}
- 
- std::cout << std::endl;
- 
- numint = 0;
- std::cout << "Please enter the number of the frames (between 1 and " << maxframesize << ")\n";
-	while (numint < 1 || numint > maxframesize)
+ std::ostringstream out;
+ out << "metric,window,key,value\n";
+	for (std::size_t b = 0; b < reuse.size(); b++)
 	{
-	 cin_custom(selectionnumber);
-		if (strToInt(selectionnumber, numint) != 0)
-		{std::cout << "This is not a valid input. Please select number between \"1\" and \"" << maxframesize << "\":\n";}
+		if (reuse[b] > 0)
+		{out << "reuse_distance,," << (1ull << b) << "," << reuse[b] << "\n";}
+	}
+ out << "reuse_distance,,inf," << firstuses << "\n";
+	for (std::size_t w = 0; w < windows.size(); w++)
+	{out << worksets[w] << "working_set_mean," << windows[w] << ",," << worksetsum[w] / refstrcount << "\n";}
+ std::vector<std::pair<int, unsigned long long>> frequencies;
+ frequencies.reserve(pages.size());
+	for (const std::pair<const int, pageUses> &page : pages)
+	{frequencies.emplace_back(page.first, page.second.uses);}
+ std::sort(frequencies.begin(), frequencies.end(), [](const std::pair<int, unsigned long long> &a, const std::pair<int, unsigned long long> &b)
+ {return (a.second != b.second ? a.second > b.second : a.first < b.first);});
+	for (const std::pair<int, unsigned long long> &page : frequencies)
+	{
+	 out << "frequency,,";
+		if (options.pageshift >= 0)
+		{out << "0x" << std::hex << interner.getAddress(page.first) << std::dec;}
 		else
+		{out << page.first;}
+	 out << "," << page.second << "\n";
+	}
+ std::cout << out.str() << std::flush;
+ return 0;
+}
+
+// This function returns the most memory (resident set size, or peak working set on Windows) this process has used so far, in
+// kilobytes, or -1 if it can't be found.
+//================================================================================================================
+long peakMemoryKb()
+{
+#if defined(_WIN32)
+ PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+	{return -1;}
+ return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+ struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+	{return -1;}
+#if defined(__APPLE__)
+ return (long)(usage.ru_maxrss / 1024); // in bytes on macOS.
+#else
+ return usage.ru_maxrss; // already in kilobytes on Linux.
+#endif
+#endif
+}
+
+// This function times every algorithm in "algvector" on every synthetic workload and number of frames, one run at a time so
+// the runs don't compete with each other, and prints one JSON object per line for each run.
+// The peak memory is the high water mark of the whole process once that run is done, so it only ever goes up.
+// Where it can't be found it's "null", never a 0 that looks real.
+//================================================================================================================
+int runBenchmark(std::vector<std::shared_ptr<algorithmType>> &algvector, const commandLine &options)
+{
+ std::vector<int> refstr;
+ workloadGenerator generator;
+	for (const workloadType &workload : options.workloads)
+	{
+	 generator.reset(workload, options.pages, options.skew, options.seed);
+	 refstr.resize(options.length);
+		for (int &page : refstr)
+		{page = generator.next();}
+		for (const int &framecount : clampFrameList(options.framesizes, options.length))
 		{
-			if (numint < 1 || numint > maxframesize)
-			{std::cout << "The number you selected was not between \"1\" and \"" << maxframesize << "\". Please try again:\n";}
+			for (const std::shared_ptr<algorithmType> &prototype : algvector)
+			{
+			 std::shared_ptr<algorithmType> alg = prototype->specialize((unsigned int)framecount);
+			 alg->setObserver(nullptr);
+			 alg->setSnapshotCapture(options.snapshots);
+			 alg->setFrameFinalSize(framecount);
+			 double seconds = 0.0;
+			 unsigned long long firstallocations = 0, allocations = 0;
+				for (int run = 0; run < options.repeat; run++) // every run after the first reuses the memory of the one before it.
+				{
+				 alg->clearAlg();
+				 alg->setRow(0);
+				 alg->setMiss(0);
+				 alg->setHit(0);
+				 unsigned long long before = heapallocations.load(std::memory_order_relaxed);
+				 std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				 alg->measureAlgorithm(options.length, refstr);
+				 std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+				 allocations = heapallocations.load(std::memory_order_relaxed) - before;
+				 seconds = std::max(elapsed.count(), 1e-9);
+					if (run == 0)
+					{firstallocations = allocations;}
+				}
+			 long peak = peakMemoryKb();
+			 std::cout << "{\"workload\":\"" << workloadGenerator::name(workload) << "\",\"algorithm\":\"" << alg->getName()
+			           << "\",\"frames\":" << alg->getFrameFinalSize() << ",\"pages\":" << options.pages << ",\"seed\":" << options.seed
+			           << ",\"references\":" << options.length << ",\"page_faults\":" << alg->getMiss() << ",\"hits\":" << alg->getHit()
+			           << ",\"seconds\":" << seconds << ",\"references_per_second\":" << options.length / seconds
+			           << ",\"ns_per_access\":" << seconds * 1e9 / options.length << ",\"runs\":" << options.repeat
+			           << ",\"first_run_allocations\":" << firstallocations << ",\"allocations\":" << allocations
+			           << ",\"peak_rss_kb\":" << (peak >= 0 ? std::to_string(peak) : std::string("null")) << "}" << std::endl;
+			}
 		}
 	}
- // min() is used here just in case refstrcount (# of elements in reference string) is less than the number of frames in each cache line.
- algorithmType :: static_setFrameFinalSize(std::min(numint, refstrcount));
- return 0; // there were no problems with the number of reference strings.
+ return 0;
 }
 
 //======================================== MAIN =============================================================MAIN=
 //================================================================================================================
-int main()
+int main(int argc, char *argv[])
 {
+ commandLine options;
+	if (argc > 1 && parseCommandLine(argc, argv, options) != 0) // non-interactive (batch) mode, read first, since it can change the algorithms.
+	{return 1;}
  std::vector<std::shared_ptr<algorithmType>> algvector;
  std::shared_ptr<algorithmType> fifo_obj (new Fifo("Fifo")); algvector.push_back(fifo_obj);
  std::shared_ptr<algorithmType> lru_obj (new Lru("LRU")); algvector.push_back(lru_obj);
  std::shared_ptr<algorithmType> opt_obj (new Opt("Optimal")); algvector.push_back(opt_obj);
  std::shared_ptr<algorithmType> opt_fifo_obj (new Opt_Fifo("Optimal with Fifo")); algvector.push_back(opt_fifo_obj);
+ std::shared_ptr<algorithmType> clock_obj (new Clock("Clock")); algvector.push_back(clock_obj);
+ std::shared_ptr<algorithmType> clock_pro_obj (new ClockPro("CLOCK-Pro")); algvector.push_back(clock_pro_obj);
+ std::shared_ptr<algorithmType> arc_obj (new Arc("ARC")); algvector.push_back(arc_obj);
+ std::shared_ptr<algorithmType> two_q_obj (new TwoQ("2Q")); algvector.push_back(two_q_obj);
+ std::shared_ptr<algorithmType> w_tinylfu_obj (new WTinyLfu("W-TinyLFU")); algvector.push_back(w_tinylfu_obj);
+ std::shared_ptr<algorithmType> lookahead_opt_obj (new LookaheadOpt("Optimal with lookahead", (unsigned int)options.lookahead)); algvector.push_back(lookahead_opt_obj);
+	if (argc > 1) // non-interactive (batch) mode.
+	{
+		if (options.bench)
+		{return runBenchmark(algvector, options);}
+		if (options.stream)
+		{return runStream(algvector, options);}
+		if (!options.tenantfile.empty())
+		{return runTenants(algvector, options);}
+		if (!options.sweepfiles.empty())
+		{return runSweep(algvector, options);}
+		if (!options.packfile.empty() || !options.unpackfile.empty())
+		{return runPackTrace(options);}
+		if (options.profile)
+		{return runProfile(options);}
+		if (options.mrcframes > 0)
+		{
+			if (options.shardsrate > 0.0 || options.shardsbudget > 0)
+			{return runSampledMissRatioCurve(options);}
+		 return runMissRatioCurve(options);
+		}
+	 return runTraceFile(algvector, options);
+	}
+	for (std::shared_ptr<algorithmType> &alg : algvector) // the interactive mode displays every cache line, so turn snapshots on.
+	{alg->setSnapshotCapture(true);}
  std::string runagainstr;
  int refstrcount; // Number of elements of the reference string
+ int framecount; // Number of frames in each cache line
  int maxrefstrsize = 50, maxframesize = 7;
  std::vector<int> refstr; // The reference string that's used by the "calculate" functions that the user defined.
 	while (runagainstr != "no")
 	{
 	 cleanUp (algvector); // On each iteration of this loop, each "calculate" function expects an empty vector. So clean everything up and reset values.
-	 getInput (refstrcount, refstr, maxrefstrsize, maxframesize); // Get input from user.
+	 getInput (refstrcount, refstr, framecount, maxrefstrsize, maxframesize); // Get input from user.
+	 setAllFrameSizes (algvector, framecount);
 	 std::cout << std::endl;
 	 calculateAllAlgorithms (algvector, refstrcount, refstr); // just calculate one: fifo_obj->calculateAlgorithm(refstrcount, refstr);
 	 displayAllAlgorithms (algvector);                        // just display one:   fifo_obj->displayAlgorithm();
@@ -685,9 +6092,9 @@ int main()
  // JUST FOR FUN - Let's sum up the last frame (column) of all algorithms and display each summed row on one line, before we display each algorithm's output!
  // THIS MUST BE PLACED AFTER THE FUNCTION "calculateAllAlgorithms"!!!
 	 //================================================================================================================
-	 std::vector<int> temp_vector(algorithmType :: static_getFrameFinalSize(), 0); // create temporary vector to store the sum of the last column of each algorithm.
+	 std::vector<int> temp_vector(algvector[0]->getFrameFinalSize(), 0); // create temporary vector to store the sum of the last column of each algorithm.
 	 std::cout << std::endl << "Sum of last cache line: ";
-		for (unsigned int i = 0; i < algorithmType :: static_getFrameFinalSize(); i++)
+		for (unsigned int i = 0; i < algvector[0]->getFrameFinalSize(); i++)
 		{
 			for (std::shared_ptr<algorithmType> alg : algvector)
 			{temp_vector.at(i) += alg->getVector()[alg->getRow()-1][i];} // .at() function is NOT used anywhere else in program, to improve performance